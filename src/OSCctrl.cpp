@@ -4,6 +4,12 @@
 #include "osc/OscReceiver.hpp"
 #include "osc/ChunkedManager.hpp"
 #include "osc/SubscriptionManager.hpp"
+#include "osc/Prewarmer.hpp"
+#include "osc/Bundler/ModuleStructureBundler.hpp"
+#include "util/WorkerPool.hpp"
+#include "util/BufferPool.hpp"
+#include "texture/OverlayContext.hpp"
+#include "texture/TextureCache.hpp"
 
 OSCctrl::OSCctrl() {
   config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
@@ -12,6 +18,9 @@ OSCctrl::OSCctrl() {
   configLight(HEARTBEAT_OUT_LIGHT, "Heartbeat Out");
   configLight(HEARTBEAT_IN_LIGHT, "Heartbeat In");
 
+  for (int i = 0; i < NUM_CV_OUTPUTS; ++i)
+    configOutput(CV_OUTPUTS + i, rack::string::f("CV stream %d", i + 1));
+
   lights[TX_LIGHT].setBrightness(0.f);
   lights[HEARTBEAT_IN_LIGHT].setBrightness(0.f);
   lights[HEARTBEAT_OUT_LIGHT].setBrightness(0.f);
@@ -19,7 +28,49 @@ OSCctrl::OSCctrl() {
   lightDivider.setDivision(16);
 }
 
+void OSCctrl::applyDirectParamWrites() {
+  DirectParamWrite write;
+  while (directParamWrites.pop(write)) applyParamWrite(write);
+}
+
+void OSCctrl::applyParamWrite(const DirectParamWrite& write) {
+  DirectParamAck ack{write.moduleId, write.paramId, -1.f, false};
+
+  // the engine is locked for the whole step, and looking a module up by id
+  // is a hash lookup, so resolving per write is as cheap as a cache and
+  // can't outlive a removed module
+  Module* target = APP->engine->getModule_NoLock(write.moduleId);
+  ParamQuantity* pq = target ? target->getParamQuantity(write.paramId) : NULL;
+
+  if (pq) {
+    pq->setValue(write.value);
+    ack.value = pq->getValue();
+    ack.success = true;
+  }
+
+  // nowhere to go if the ui is behind, the client can resend
+  if (write.needsAck) directParamAcks.push(ack);
+}
+
 void OSCctrl::process(const ProcessArgs& args) {
+  applyDirectParamWrites();
+
+  if (!paramScheduler.idle()) {
+    // this sample's time, from when the engine started the block
+    double now = APP->engine->getBlockTime()
+      + (args.frame - APP->engine->getBlockFrame()) * args.sampleTime;
+    paramScheduler.process(now, [this](const DirectParamWrite& write) {
+      applyParamWrite(write);
+    });
+  }
+
+  for (int i = 0; i < NUM_CV_OUTPUTS; ++i) {
+    Output& output = outputs[CV_OUTPUTS + i];
+    output.setChannels(cvStreams[i].process(args.sampleRate, output.getVoltages()));
+  }
+
+  for (PortTap& tap : portTaps) tap.process();
+
   if (lightDivider.process()) {
     if (broadcasting) {
       lights[TX_LIGHT].setBrightnessSmooth(
@@ -58,6 +109,17 @@ void OSCctrl::process(const ProcessArgs& args) {
   }
 }
 
+json_t* OSCctrl::dataToJson() {
+  json_t* rootJ = json_object();
+  json_object_set_new(rootJ, "prewarmTextures", json_boolean(prewarmTextures));
+  return rootJ;
+}
+
+void OSCctrl::dataFromJson(json_t* rootJ) {
+  json_t* prewarmJ = json_object_get(rootJ, "prewarmTextures");
+  if (prewarmJ) prewarmTextures = json_boolean_value(prewarmJ);
+}
+
 OSCctrlWidget::OSCctrlWidget(OSCctrl* module) {
   setModule(module);
   setPanel(createPanel(asset::plugin(pluginInstance, "res/OSCctrl.svg")));
@@ -99,6 +161,14 @@ OSCctrlWidget::OSCctrlWidget(OSCctrl* module) {
   // hbOutLight->borderColor = lightBgColor;
   addChild(hbOutLight);
 
+  for (int i = 0; i < OSCctrl::NUM_CV_OUTPUTS; ++i) {
+    addOutput(createOutputCentered<PJ301MPort>(
+      mm2px(Vec(i % 2 == 0 ? 9.220 : 21.260, 100.0 + (i / 2) * 12.0)),
+      module,
+      OSCctrl::CV_OUTPUTS + i
+    ));
+  }
+
   if (!module) return;
 
   // bail if OSCctrl is already in the patch
@@ -117,38 +187,116 @@ OSCctrlWidget::OSCctrlWidget(OSCctrl* module) {
   }
 
   osctx = new OscSender(this);
+  rasterPool = new WorkerPool();
   chunkman = new ChunkedManager(this, osctx);
   subman = new SubscriptionManager(this, osctx, chunkman);
   oscrx = new OscReceiver(this, osctx, chunkman, subman);
+  prewarmer = new Prewarmer(this);
 }
 
 OSCctrlWidget::~OSCctrlWidget() {
+  // the browser preview and duplicate instances never start a receiver, the
+  // shared caches belong to the one that did
+  bool ownsCaches = oscrx != NULL;
+
+  // joins running raster jobs, which call back into the receiver
+  if (rasterPool) delete rasterPool;
   if (oscrx) delete oscrx;
+  if (prewarmer) delete prewarmer;
   if (subman) delete subman;
   if (chunkman) delete chunkman;
   if (osctx) delete osctx;
+
+  if (!ownsCaches) return;
+
+  OverlayContext::clear();
+  TextureCache::clear();
+  ModuleStructureBundler::clearCache();
+  BufferPool::clear();
 }
 
 void OSCctrlWidget::step() {
   ModuleWidget::step();
   if (!module) return;
 
+  if (firstStep && prewarmer) {
+    firstStep = false;
+    // a patch just loaded, nothing from before it can be current
+    OverlayContext::clear();
+    if (getModule<OSCctrl>()->prewarmTextures) prewarmer->start();
+  }
+
+  // before queued overlay renders can reach a removed module's surrogate
+  OverlayContext::prune();
+
   subman->tick();
   processActionQueue();
+  oscrx->sendDirectParamAcks();
+  if (prewarmer) prewarmer->step();
+}
+
+void OSCctrlWidget::appendContextMenu(Menu* menu) {
+  OSCctrl* module = getModule<OSCctrl>();
+  if (!module || !prewarmer) return;
+
+  menu->addChild(new MenuSeparator);
+  menu->addChild(createBoolMenuItem(
+    "Pre-warm textures after patch load",
+    "",
+    [=]() { return module->prewarmTextures; },
+    [=](bool prewarm) {
+      module->prewarmTextures = prewarm;
+      if (prewarm) {
+        prewarmer->start();
+      } else {
+        prewarmer->stop();
+      }
+    }
+  ));
 }
 
 void OSCctrlWidget::enqueueAction(Action action) {
   std::lock_guard<std::mutex> locker(actionMutex);
-  actionQueue.push(action);
+  actionQueue.push_back(std::move(action));
 }
 
 void OSCctrlWidget::processActionQueue() {
-  std::lock_guard<std::mutex> locker(actionMutex);
-  while (!actionQueue.empty()) {
-    auto action = actionQueue.front();
-    action();
-    actionQueue.pop();
+  {
+    std::lock_guard<std::mutex> locker(actionMutex);
+    if (pendingActions.empty()) {
+      pendingActions.swap(actionQueue);
+    } else {
+      // behind from last frame, new actions go after the carried over ones
+      for (Action& action : actionQueue)
+        pendingActions.push_back(std::move(action));
+      actionQueue.clear();
+    }
   }
+
+  if (pendingActions.empty()) return;
+
+  double start = rack::system::getTime();
+  double deadline = start + ACTION_BUDGET;
+
+  do {
+    Action action = std::move(pendingActions.front());
+    pendingActions.pop_front();
+
+    double actionStart = rack::system::getTime();
+    action();
+    double actionTime = rack::system::getTime() - actionStart;
+
+    ++actionStats.executed;
+    actionStats.totalTime += actionTime;
+    actionStats.maxTime = std::max(actionStats.maxTime, actionTime);
+  } while (!pendingActions.empty() && rack::system::getTime() < deadline);
+
+  if (!pendingActions.empty()) ++actionStats.carriedOver;
+}
+
+int32_t OSCctrlWidget::getActionQueueDepth() {
+  std::lock_guard<std::mutex> locker(actionMutex);
+  return actionQueue.size() + pendingActions.size();
 }
 
 Model* modelOSCctrl = createModel<OSCctrl, OSCctrlWidget>("OSCctrl");
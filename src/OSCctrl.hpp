@@ -1,9 +1,13 @@
 #include "plugin.hpp"
+#include "util/SpscRing.hpp"
+#include "osc/ParamScheduler.hpp"
+#include "osc/CvStream.hpp"
+#include "osc/PortTap.hpp"
 
 #include <functional>
 #include <map>
 #include <mutex>
-#include <queue>
+#include <deque>
 #include <utility>
 
 struct OSCctrl;
@@ -11,6 +15,8 @@ class OscSender;
 class OscReceiver;
 class ChunkedManager;
 class SubscriptionManager;
+struct WorkerPool;
+struct Prewarmer;
 
 typedef std::function<void(void)> Action;
 
@@ -31,6 +37,9 @@ struct SceneAction : rack::widget::Widget {
 };
 
 struct OSCctrl : Module {
+  static const int NUM_CV_OUTPUTS{4};
+  static const int NUM_PORT_TAPS{8};
+
   enum ParamId {
     PARAMS_LEN
   };
@@ -38,6 +47,7 @@ struct OSCctrl : Module {
     INPUTS_LEN
   };
   enum OutputId {
+    ENUMS(CV_OUTPUTS, NUM_CV_OUTPUTS),
     OUTPUTS_LEN
   };
   enum LightId {
@@ -48,6 +58,8 @@ struct OSCctrl : Module {
   };
 
   bool broadcasting{true};
+  // render textures into the cache after the patch loads, saved with the patch
+  bool prewarmTextures{false};
 
   rack::dsp::PulseGenerator txPulse;
   rack::dsp::PulseGenerator hbInPulse;
@@ -57,8 +69,26 @@ struct OSCctrl : Module {
 
   rack::dsp::SchmittTrigger bcastEchoThreshold;
 
+  // receiver thread -> audio thread, applied at the top of process
+  SpscRing<DirectParamWrite, 1024> directParamWrites;
+  // audio thread -> ui thread, sent by OscReceiver::sendDirectParamAcks
+  SpscRing<DirectParamAck, 1024> directParamAcks;
+  // timetagged writes, applied at their sample
+  ParamScheduler paramScheduler;
+
+  // /stream/cv, one per CV output
+  CvStream cvStreams[NUM_CV_OUTPUTS];
+
+  // /subscribe/port, sampled at the end of process
+  PortTap portTaps[NUM_PORT_TAPS];
+  void applyDirectParamWrites();
+  void applyParamWrite(const DirectParamWrite& write);
+
   OSCctrl();
   void process(const ProcessArgs &args) override;
+
+  json_t* dataToJson() override;
+  void dataFromJson(json_t* rootJ) override;
 };
 
 struct OSCctrlWidget : ModuleWidget {
@@ -66,15 +96,40 @@ struct OSCctrlWidget : ModuleWidget {
   OscReceiver* oscrx = NULL;
   ChunkedManager* chunkman = NULL;
   SubscriptionManager* subman = NULL;
+  // rasterizes svg textures off the UI thread
+  WorkerPool* rasterPool = NULL;
+  Prewarmer* prewarmer = NULL;
+  // the rest of the patch is in place by the first step
+  bool firstStep{true};
 
   OSCctrlWidget(OSCctrl* module);
   ~OSCctrlWidget();
 
   virtual void step() override;
+  void appendContextMenu(Menu* menu) override;
 
-  // enqueue actions that need to run on the render thread
-  std::queue<Action> actionQueue;
+  // enqueue actions that need to run on the render thread. producers only
+  // hold actionMutex for a push, the ui swaps the whole queue out and runs
+  // it unlocked.
+  std::deque<Action> actionQueue;
   std::mutex actionMutex;
   void enqueueAction(Action action);
+
+  // swapped out but not run yet, ui thread only
+  std::deque<Action> pendingActions;
+  // seconds of each frame spent running actions, the rest carry over. one
+  // action always runs, so a long one can go over.
+  static constexpr double ACTION_BUDGET{0.008};
   void processActionQueue();
+
+  // since the last /get/action_stats, ui thread only
+  struct ActionStats {
+    int32_t executed{0};
+    double totalTime{0.0};
+    double maxTime{0.0};
+    // frames that ran out of budget with actions left
+    int32_t carriedOver{0};
+  } actionStats;
+  // waiting to run, queued and swapped out
+  int32_t getActionQueueDepth();
 };
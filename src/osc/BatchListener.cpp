@@ -0,0 +1,121 @@
+#ifdef ARCH_LIN
+
+#include "BatchListener.hpp"
+
+#include "rack.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+#include "oscpack/osc/OscException.h"
+
+BatchListener::BatchListener(
+  const IpEndpointName& endpoint,
+  PacketListener* _listener
+): listener(_listener), buffers(BATCH_SIZE * BUFFER_STRIDE) {
+  socketFd = socket(AF_INET, SOCK_DGRAM, 0);
+  if (socketFd == -1) throw std::runtime_error("unable to create udp socket");
+
+  sockaddr_in bindAddress;
+  std::memset(&bindAddress, 0, sizeof(bindAddress));
+  bindAddress.sin_family = AF_INET;
+  bindAddress.sin_addr.s_addr =
+    endpoint.address == IpEndpointName::ANY_ADDRESS
+      ? INADDR_ANY
+      : htonl(endpoint.address);
+  bindAddress.sin_port =
+    endpoint.port == IpEndpointName::ANY_PORT ? 0 : htons(endpoint.port);
+
+  if (bind(socketFd, (sockaddr*)&bindAddress, sizeof(bindAddress)) < 0) {
+    close(socketFd);
+    throw std::runtime_error("unable to bind udp socket");
+  }
+
+  breakFd = eventfd(0, EFD_NONBLOCK);
+  if (breakFd == -1) {
+    close(socketFd);
+    throw std::runtime_error("unable to create break eventfd");
+  }
+}
+
+BatchListener::~BatchListener() {
+  if (socketFd != -1) close(socketFd);
+  if (breakFd != -1) close(breakFd);
+}
+
+void BatchListener::AsynchronousBreak() {
+  breaking = true;
+  uint64_t one{1};
+  if (write(breakFd, &one, sizeof(one)) < 0)
+    WARN("BatchListener: failed to signal break, %s", std::strerror(errno));
+}
+
+void BatchListener::prepareBatch() {
+  for (unsigned int i = 0; i < BATCH_SIZE; ++i) {
+    iovecs[i].iov_base = buffers.data() + i * BUFFER_STRIDE;
+    iovecs[i].iov_len = MAX_DATAGRAM_SIZE;
+
+    std::memset(&messages[i].msg_hdr, 0, sizeof(messages[i].msg_hdr));
+    messages[i].msg_hdr.msg_iov = &iovecs[i];
+    messages[i].msg_hdr.msg_iovlen = 1;
+    messages[i].msg_hdr.msg_name = &addresses[i];
+    messages[i].msg_hdr.msg_namelen = sizeof(addresses[i]);
+    messages[i].msg_len = 0;
+  }
+}
+
+void BatchListener::Run() {
+  pollfd fds[2];
+  fds[0].fd = socketFd;
+  fds[0].events = POLLIN;
+  fds[1].fd = breakFd;
+  fds[1].events = POLLIN;
+
+  while (!breaking) {
+    fds[0].revents = 0;
+    fds[1].revents = 0;
+    if (poll(fds, 2, -1) < 0) {
+      if (errno == EINTR) continue;
+      WARN("BatchListener: poll failed, %s", std::strerror(errno));
+      return;
+    }
+    if (breaking || (fds[1].revents & POLLIN)) return;
+    if (!(fds[0].revents & POLLIN)) continue;
+
+    // keep taking full batches until the socket is drained
+    while (!breaking) {
+      prepareBatch();
+      int received = recvmmsg(socketFd, messages, BATCH_SIZE, MSG_DONTWAIT, NULL);
+      if (received <= 0) break;
+
+      for (int i = 0; i < received; ++i) {
+        if (messages[i].msg_len == 0) continue;
+
+        IpEndpointName remoteEndpoint(
+          ntohl(addresses[i].sin_addr.s_addr),
+          ntohs(addresses[i].sin_port)
+        );
+
+        // parsed in place, a malformed datagram only loses itself
+        try {
+          listener->ProcessPacket(
+            buffers.data() + i * BUFFER_STRIDE,
+            messages[i].msg_len,
+            remoteEndpoint
+          );
+        } catch (osc::Exception& e) {
+          WARN("BatchListener: dropped malformed packet, %s", e.what());
+        }
+      }
+
+      if ((unsigned int)received < BATCH_SIZE) break;
+    }
+  }
+}
+
+#endif
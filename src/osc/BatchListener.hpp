@@ -0,0 +1,49 @@
+#pragma once
+
+#ifdef ARCH_LIN
+
+#include <atomic>
+#include <vector>
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+#include "oscpack/ip/IpEndpointName.h"
+#include "oscpack/ip/PacketListener.h"
+
+// stands in for oscpack's UdpListeningReceiveSocket on linux. each wakeup
+// takes up to BATCH_SIZE datagrams with one recvmmsg instead of a recvfrom
+// per datagram, and hands them to the listener straight from the buffers.
+struct BatchListener {
+  static const unsigned int BATCH_SIZE{32};
+  // same limit as oscpack's receive loop
+  static const size_t MAX_DATAGRAM_SIZE{4098};
+  // each datagram starts 8 byte aligned for the parser
+  static const size_t BUFFER_STRIDE{(MAX_DATAGRAM_SIZE + 7) & ~(size_t)7};
+
+  // throws std::runtime_error if the socket can't be bound, like oscpack
+  BatchListener(const IpEndpointName& endpoint, PacketListener* _listener);
+  ~BatchListener();
+
+  // blocks until AsynchronousBreak
+  void Run();
+  // from any other thread
+  void AsynchronousBreak();
+
+private:
+  PacketListener* listener;
+  int socketFd{-1};
+  // written to wake Run up when it's time to stop
+  int breakFd{-1};
+  std::atomic<bool> breaking{false};
+
+  std::vector<char> buffers;
+  mmsghdr messages[BATCH_SIZE];
+  iovec iovecs[BATCH_SIZE];
+  sockaddr_in addresses[BATCH_SIZE];
+
+  // reset the headers recvmmsg wrote sizes into
+  void prepareBatch();
+};
+
+#endif
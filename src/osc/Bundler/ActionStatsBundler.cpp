@@ -0,0 +1,23 @@
+#include "ActionStatsBundler.hpp"
+
+ActionStatsBundler::ActionStatsBundler(
+  int32_t depth,
+  int32_t executed,
+  double totalTime,
+  double maxTime,
+  int32_t carriedOver
+) : Bundler("ActionStatsBundler") {
+  float averageMs = executed > 0 ? totalTime * 1000.0 / executed : 0.f;
+  float maxMs = maxTime * 1000.0;
+
+  messages.emplace_back(
+    "/action_stats",
+    [=](osc::OutboundPacketStream& pstream) {
+      pstream << depth
+        << executed
+        << averageMs
+        << maxMs
+        << carriedOver;
+    }
+  );
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "Bundler.hpp"
+
+struct ActionStatsBundler : Bundler {
+  ActionStatsBundler(
+    int32_t depth,
+    int32_t executed,
+    double totalTime,
+    double maxTime,
+    int32_t carriedOver
+  );
+};
@@ -0,0 +1,41 @@
+#include "CableBatchAckBundler.hpp"
+
+#include <algorithm>
+#include <memory>
+
+CableBatchAckBundler::CableBatchAckBundler(
+  CableAckType type,
+  int64_t returnId,
+  const std::vector<int64_t>& cableIds
+) : Bundler("CableBatchAckBundler") {
+  assert(type != CableAckType::Unknown);
+
+  const char* address =
+    type == CableAckType::Add ? "/ack/cables/add" : "/ack/cables/remove";
+  int32_t total = cableIds.size();
+  size_t perMessage = MAX_BLOB_SIZE / sizeof(int64_t);
+
+  // an empty batch still gets its ack
+  size_t first{0};
+  do {
+    size_t count = std::min(perMessage, cableIds.size() - first);
+
+    auto ids = std::make_shared<std::vector<int64_t>>(
+      cableIds.begin() + first,
+      cableIds.begin() + first + count
+    );
+
+    int32_t firstCable = first;
+    messages.emplace_back(
+      address,
+      [=](osc::OutboundPacketStream& pstream) {
+        pstream << returnId
+          << firstCable
+          << total
+          << osc::Blob(ids->data(), ids->size() * sizeof(int64_t));
+      }
+    );
+
+    first += count;
+  } while (first < cableIds.size());
+}
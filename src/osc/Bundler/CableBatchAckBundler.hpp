@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Bundler.hpp"
+#include "CableAckBundler.hpp"
+
+#include <vector>
+
+// a /add/cables or /remove/cables batch after it was applied, as few
+// /ack/cables/add or /ack/cables/remove messages as fit it
+struct CableBatchAckBundler : Bundler {
+  // cable id bytes per message
+  static const size_t MAX_BLOB_SIZE{1024};
+
+  // one cable id per requested cable, in request order, -1 where it failed
+  CableBatchAckBundler(
+    CableAckType type,
+    int64_t returnId,
+    const std::vector<int64_t>& cableIds
+  );
+};
@@ -10,7 +10,14 @@ ChunkedImageBundler::ChunkedImageBundler(
   uint8_t* data,
   int32_t thisChunkSize,
   int32_t _width,
-  int32_t _height
+  int32_t _height,
+  int32_t _offsetX,
+  int32_t _offsetY,
+  int32_t _originalWidth,
+  int32_t _originalHeight,
+  int32_t _codec,
+  int32_t _format,
+  uint32_t _tint
 ): Bundler("ChunkedImageBundler"),
   ChunkedSendBundler(
     "/set/texture",
@@ -23,12 +30,26 @@ ChunkedImageBundler::ChunkedImageBundler(
     thisChunkSize
   ),
   width(_width),
-  height(_height) {}
+  height(_height),
+  offsetX(_offsetX),
+  offsetY(_offsetY),
+  originalWidth(_originalWidth),
+  originalHeight(_originalHeight),
+  codec(_codec),
+  format(_format),
+  tint(_tint) {}
 
 void ChunkedImageBundler::bundleMetadata(osc::OutboundPacketStream& pstream) {
   ChunkedSendBundler::bundleMetadata(pstream);
 
   pstream << width
     << height
+    << offsetX
+    << offsetY
+    << originalWidth
+    << originalHeight
+    << codec
+    << format
+    << (int32_t)tint
     ;
 }
@@ -15,11 +15,25 @@ struct ChunkedImageBundler : ChunkedSendBundler {
     uint8_t* data,
     int32_t thisChunkSize,
     int32_t width,
-    int32_t height
+    int32_t height,
+    int32_t offsetX,
+    int32_t offsetY,
+    int32_t originalWidth,
+    int32_t originalHeight,
+    int32_t codec,
+    int32_t format,
+    uint32_t tint
   );
 
   int32_t width;
   int32_t height;
+  int32_t offsetX;
+  int32_t offsetY;
+  int32_t originalWidth;
+  int32_t originalHeight;
+  int32_t codec;
+  int32_t format;
+  uint32_t tint;
 
   void bundleMetadata(osc::OutboundPacketStream& pstream) override;
 };
@@ -0,0 +1,48 @@
+#include "ChunkedOverlayFrameBundler.hpp"
+
+#include "../../texture/TileDiff.hpp"
+
+ChunkedOverlayFrameBundler::ChunkedOverlayFrameBundler(
+  int64_t chunkedSendId,
+  int32_t chunkNum,
+  int32_t numChunks,
+  int32_t chunkSize,
+  int64_t totalSize,
+  uint8_t* data,
+  int32_t thisChunkSize,
+  int64_t _moduleId,
+  int32_t _frameNum,
+  int32_t _width,
+  int32_t _height,
+  bool _keyframe,
+  int32_t _codec
+): Bundler("ChunkedOverlayFrameBundler"),
+  ChunkedSendBundler(
+    "/set/overlay/frame",
+    chunkedSendId,
+    chunkNum,
+    numChunks,
+    chunkSize,
+    totalSize,
+    data,
+    thisChunkSize
+  ),
+  moduleId(_moduleId),
+  frameNum(_frameNum),
+  width(_width),
+  height(_height),
+  keyframe(_keyframe),
+  codec(_codec) {}
+
+void ChunkedOverlayFrameBundler::bundleMetadata(osc::OutboundPacketStream& pstream) {
+  ChunkedSendBundler::bundleMetadata(pstream);
+
+  pstream << moduleId
+    << frameNum
+    << width
+    << height
+    << TileDiff::TILE_SIZE
+    << keyframe
+    << codec
+    ;
+}
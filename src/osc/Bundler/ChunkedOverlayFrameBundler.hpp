@@ -0,0 +1,30 @@
+#pragma once
+
+#include "ChunkedSendBundler.hpp"
+
+struct ChunkedOverlayFrameBundler : ChunkedSendBundler {
+  ChunkedOverlayFrameBundler(
+    int64_t chunkedSendId,
+    int32_t chunkNum,
+    int32_t numChunks,
+    int32_t chunkSize,
+    int64_t totalSize,
+    uint8_t* data,
+    int32_t thisChunkSize,
+    int64_t moduleId,
+    int32_t frameNum,
+    int32_t width,
+    int32_t height,
+    bool keyframe,
+    int32_t codec
+  );
+
+  int64_t moduleId;
+  int32_t frameNum;
+  int32_t width;
+  int32_t height;
+  bool keyframe;
+  int32_t codec;
+
+  void bundleMetadata(osc::OutboundPacketStream& pstream) override;
+};
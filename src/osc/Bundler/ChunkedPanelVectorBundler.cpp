@@ -0,0 +1,39 @@
+#include "ChunkedPanelVectorBundler.hpp"
+
+ChunkedPanelVectorBundler::ChunkedPanelVectorBundler(
+  int64_t chunkedSendId,
+  int32_t chunkNum,
+  int32_t numChunks,
+  int32_t chunkSize,
+  int64_t totalSize,
+  uint8_t* data,
+  int32_t thisChunkSize,
+  const std::string& _pluginSlug,
+  const std::string& _moduleSlug,
+  float _width,
+  float _height
+): Bundler("ChunkedPanelVectorBundler"),
+  ChunkedSendBundler(
+    "/set/panel_vector",
+    chunkedSendId,
+    chunkNum,
+    numChunks,
+    chunkSize,
+    totalSize,
+    data,
+    thisChunkSize
+  ),
+  pluginSlug(_pluginSlug),
+  moduleSlug(_moduleSlug),
+  width(_width),
+  height(_height) {}
+
+void ChunkedPanelVectorBundler::bundleMetadata(osc::OutboundPacketStream& pstream) {
+  ChunkedSendBundler::bundleMetadata(pstream);
+
+  pstream << pluginSlug.c_str()
+    << moduleSlug.c_str()
+    << width
+    << height
+    ;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "ChunkedSendBundler.hpp"
+
+struct ChunkedPanelVectorBundler : ChunkedSendBundler {
+  ChunkedPanelVectorBundler(
+    int64_t chunkedSendId,
+    int32_t chunkNum,
+    int32_t numChunks,
+    int32_t chunkSize,
+    int64_t totalSize,
+    uint8_t* data,
+    int32_t thisChunkSize,
+    const std::string& pluginSlug,
+    const std::string& moduleSlug,
+    float width,
+    float height
+  );
+
+  std::string pluginSlug;
+  std::string moduleSlug;
+  float width;
+  float height;
+
+  void bundleMetadata(osc::OutboundPacketStream& pstream) override;
+};
@@ -0,0 +1,23 @@
+#include "CvStreamStatsBundler.hpp"
+#include "../CvStream.hpp"
+
+CvStreamStatsBundler::CvStreamStatsBundler(
+  int32_t outputId,
+  const CvStream& stream
+) : Bundler("CvStreamStatsBundler") {
+  int32_t underruns = stream.underruns;
+  int32_t overruns = stream.overruns;
+  float depthMs = stream.depth * 1000.f;
+  int32_t buffered = stream.buffered();
+
+  messages.emplace_back(
+    "/stream/cv/stats",
+    [=](osc::OutboundPacketStream& pstream) {
+      pstream << outputId
+        << underruns
+        << overruns
+        << depthMs
+        << buffered;
+    }
+  );
+}
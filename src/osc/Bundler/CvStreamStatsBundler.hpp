@@ -0,0 +1,9 @@
+#pragma once
+
+#include "Bundler.hpp"
+
+struct CvStream;
+
+struct CvStreamStatsBundler : Bundler {
+  CvStreamStatsBundler(int32_t outputId, const CvStream& stream);
+};
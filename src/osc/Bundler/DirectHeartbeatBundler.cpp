@@ -1,13 +1,14 @@
 #include "DirectHeartbeatBundler.hpp"
 
-DirectHeartbeatBundler::DirectHeartbeatBundler(): Bundler("DirectHeartbeatBundler") {
+DirectHeartbeatBundler::DirectHeartbeatBundler(int32_t lateParamWrites):
+  Bundler("DirectHeartbeatBundler") {
   float avg = (float)APP->engine->getMeterAverage() * 100;
   float max = (float)APP->engine->getMeterMax() * 100;
 
   messages.emplace_back(
     "/heartbeat",
-    [avg, max](osc::OutboundPacketStream& pstream) {
-      pstream << avg << max;
+    [avg, max, lateParamWrites](osc::OutboundPacketStream& pstream) {
+      pstream << avg << max << lateParamWrites;
     }
   );
 }
@@ -3,5 +3,5 @@
 #include "Bundler.hpp"
 
 struct DirectHeartbeatBundler : Bundler {
-  DirectHeartbeatBundler();
+  DirectHeartbeatBundler(int32_t lateParamWrites);
 };
@@ -0,0 +1,40 @@
+#include "ModuleAtlasBundler.hpp"
+
+ModuleAtlasBundler::ModuleAtlasBundler(
+  int64_t atlasId,
+  const std::string& pluginSlug,
+  const std::string& moduleSlug,
+  const AtlasResult& atlas
+): Bundler("ModuleAtlasBundler") {
+  int32_t width = atlas.render.width;
+  int32_t height = atlas.render.height;
+  int32_t numEntries = atlas.entries.size();
+
+  messages.emplace_back(
+    "/set/module_atlas",
+    [=](osc::OutboundPacketStream& pstream) {
+      pstream << atlasId
+        << pluginSlug.c_str()
+        << moduleSlug.c_str()
+        << width
+        << height
+        << numEntries
+        ;
+    }
+  );
+
+  for (const AtlasEntry& entry : atlas.entries) {
+    messages.emplace_back(
+      "/set/module_atlas/uv",
+      [=](osc::OutboundPacketStream& pstream) {
+        pstream << atlasId
+          << entry.textureId
+          << entry.x
+          << entry.y
+          << entry.width
+          << entry.height
+          ;
+      }
+    );
+  }
+}
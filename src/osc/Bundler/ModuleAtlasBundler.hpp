@@ -0,0 +1,14 @@
+#pragma once
+
+#include "Bundler.hpp"
+
+#include "../../texture/Atlas.hpp"
+
+struct ModuleAtlasBundler : Bundler {
+  ModuleAtlasBundler(
+    int64_t atlasId,
+    const std::string& pluginSlug,
+    const std::string& moduleSlug,
+    const AtlasResult& atlas
+  );
+};
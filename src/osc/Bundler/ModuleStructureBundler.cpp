@@ -11,6 +11,21 @@ ModuleStructureBundler::ModuleStructureBundler(
   moduleSlug(_moduleSlug)
 {
   rack::plugin::Model* model = gtnosft::util::findModel(pluginSlug, moduleSlug);
+  if (!model) return;
+
+  CacheKey key{
+    pluginSlug,
+    moduleSlug,
+    model->plugin->version,
+    rack::settings::preferDarkPanels
+  };
+  auto cached = cache.find(key);
+  if (cached != cache.end()) {
+    addMessages(cached->second);
+    ++structureIdCounter;
+    return;
+  }
+
   rack::app::ModuleWidget* moduleWidget =
     gtnosft::util::makeConnectedModuleWidget(model);
   if (!moduleWidget) return;
@@ -28,11 +43,19 @@ ModuleStructureBundler::ModuleStructureBundler(
 
   int64_t textureId = Catalog::pullPanelId(moduleWidget);
 
-  messages.emplace(
-    messages.begin(),
+  parts.emplace(
+    parts.begin(),
     "/set/module_structure",
-    [=, this](osc::OutboundPacketStream& pstream) {
-      pstream << id
+    [
+      =,
+      pluginSlug = pluginSlug,
+      moduleSlug = moduleSlug,
+      numParams = numParams,
+      numInputs = numInputs,
+      numOutputs = numOutputs,
+      numLights = numLights
+    ](osc::OutboundPacketStream& pstream, int32_t structureId) {
+      pstream << structureId
         << pluginSlug.c_str()
         << moduleSlug.c_str()
         << panelSize.x
@@ -47,9 +70,32 @@ ModuleStructureBundler::ModuleStructureBundler(
   );
 
   delete moduleWidget;
+
+  std::shared_ptr<const std::vector<Part>> built =
+    std::make_shared<const std::vector<Part>>(std::move(parts));
+  cache[key] = built;
+  addMessages(built);
   ++structureIdCounter;
 }
 
+void ModuleStructureBundler::addMessages(
+  std::shared_ptr<const std::vector<Part>> structure
+) {
+  int32_t structureId = id;
+  for (size_t i = 0; i < structure->size(); ++i) {
+    messages.emplace_back(
+      (*structure)[i].first,
+      [structure, i, structureId](osc::OutboundPacketStream& pstream) {
+        (*structure)[i].second(pstream, structureId);
+      }
+    );
+  }
+}
+
+void ModuleStructureBundler::clearCache() {
+  cache.clear();
+}
+
 void ModuleStructureBundler::addLightMessage(
   rack::app::LightWidget* lightWidget,
   int32_t paramId
@@ -65,10 +111,11 @@ void ModuleStructureBundler::addLightMessage(
     if (paramId != -1) INFO("  - light %d (param %d)", lightId, paramId);
   }
 
-  messages.emplace_back(
+  parts.emplace_back(
     "/set/module_structure/light",
-    [this, lightId, paramId, size, pos, defaultVisible, bgColorHex](
-      osc::OutboundPacketStream& pstream
+    [lightId, paramId, size, pos, defaultVisible, bgColorHex](
+      osc::OutboundPacketStream& pstream,
+      int32_t structureId
     ) {
       // TODO: we're assuming lights with a perfectly square size are
       //       circular. we should render the widget and check for
@@ -80,7 +127,7 @@ void ModuleStructureBundler::addLightMessage(
           ? LightShape::Round
           : LightShape::Rectangle;
 
-      pstream << id
+      pstream << structureId
         << lightId
         << paramId
         << (int32_t)lightShape
@@ -225,10 +272,10 @@ void ModuleStructureBundler::addParamMessages(rack::app::ModuleWidget* moduleWid
       );
     }
 
-    messages.emplace_back(
+    parts.emplace_back(
       "/set/module_structure/param",
-      [=, this](osc::OutboundPacketStream& pstream) {
-        pstream << id
+      [=](osc::OutboundPacketStream& pstream, int32_t structureId) {
+        pstream << structureId
           << paramId
           << (int32_t)type
           << name.c_str()
@@ -266,10 +313,10 @@ void ModuleStructureBundler::addParamMessages(rack::app::ModuleWidget* moduleWid
       std::vector<int64_t> textureIds =
         Catalog::pullIds(ParamType::Knob, knobWidget);
 
-      messages.emplace_back(
+      parts.emplace_back(
         "/set/module_structure/param/knob",
-        [=, this](osc::OutboundPacketStream& pstream) {
-          pstream << id
+        [=](osc::OutboundPacketStream& pstream, int32_t structureId) {
+          pstream << structureId
             << paramId
             << minAngle
             << maxAngle
@@ -297,10 +344,10 @@ void ModuleStructureBundler::addParamMessages(rack::app::ModuleWidget* moduleWid
       std::vector<int64_t> textureIds =
         Catalog::pullIds(ParamType::Slider, sliderWidget);
 
-      messages.emplace_back(
+      parts.emplace_back(
         "/set/module_structure/param/slider",
-        [=, this](osc::OutboundPacketStream& pstream) {
-          pstream << id
+        [=](osc::OutboundPacketStream& pstream, int32_t structureId) {
+          pstream << structureId
             << paramId
             << handleSize.x
             << handleSize.y
@@ -323,13 +370,14 @@ void ModuleStructureBundler::addParamMessages(rack::app::ModuleWidget* moduleWid
         INFO("    %s", momentary ? "momentary" : "latch");
       }
 
+      int64_t stripTextureId;
       std::vector<int64_t> textureIds =
-        Catalog::pullIds(ParamType::Button, switchWidget);
+        Catalog::pullSwitchIds(switchWidget, stripTextureId);
 
-      messages.emplace_back(
+      parts.emplace_back(
         "/set/module_structure/param/button",
-        [=, this](osc::OutboundPacketStream& pstream) {
-          pstream << id
+        [=](osc::OutboundPacketStream& pstream, int32_t structureId) {
+          pstream << structureId
             << paramId
             << momentary
             ;
@@ -339,6 +387,8 @@ void ModuleStructureBundler::addParamMessages(rack::app::ModuleWidget* moduleWid
           }
         }
       );
+
+      addFramesMessage(paramId, textureIds.size(), stripTextureId);
     }
 
     if (type == ParamType::Switch && switchWidget) {
@@ -349,13 +399,14 @@ void ModuleStructureBundler::addParamMessages(rack::app::ModuleWidget* moduleWid
         INFO("    %d frames", numFrames);
       }
 
+      int64_t stripTextureId;
       std::vector<int64_t> textureIds =
-        Catalog::pullIds(ParamType::Button, switchWidget);
+        Catalog::pullSwitchIds(switchWidget, stripTextureId);
 
-      messages.emplace_back(
+      parts.emplace_back(
         "/set/module_structure/param/switch",
-        [=, this](osc::OutboundPacketStream& pstream) {
-          pstream << id
+        [=](osc::OutboundPacketStream& pstream, int32_t structureId) {
+          pstream << structureId
             << paramId
             << numFrames
             << horizontal
@@ -366,10 +417,29 @@ void ModuleStructureBundler::addParamMessages(rack::app::ModuleWidget* moduleWid
           }
         }
       );
+
+      addFramesMessage(paramId, textureIds.size(), stripTextureId);
     }
   }
 }
 
+void ModuleStructureBundler::addFramesMessage(
+  int32_t paramId,
+  int32_t numFrames,
+  int64_t stripTextureId
+) {
+  parts.emplace_back(
+    "/set/module_structure/param/frames",
+    [=](osc::OutboundPacketStream& pstream, int32_t structureId) {
+      pstream << structureId
+        << paramId
+        << numFrames
+        << stripTextureId // Switch_strip
+        ;
+    }
+  );
+}
+
 void ModuleStructureBundler::addPortMessages(rack::app::ModuleWidget* moduleWidget) {
   int32_t portId;
   PortType type;
@@ -398,12 +468,13 @@ void ModuleStructureBundler::addPortMessages(rack::app::ModuleWidget* moduleWidg
 
     int64_t textureId = Catalog::pullId(type, portWidget);
 
-    messages.emplace_back(
+    parts.emplace_back(
       "/set/module_structure/port",
-      [=, this](
-        osc::OutboundPacketStream& pstream
+      [=](
+        osc::OutboundPacketStream& pstream,
+        int32_t structureId
       ) {
-        pstream << id
+        pstream << structureId
           << portId
           << (int32_t)type
           << name.c_str()
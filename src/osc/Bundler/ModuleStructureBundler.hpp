@@ -2,7 +2,10 @@
 
 #include "Bundler.hpp"
 
+#include <map>
+#include <memory>
 #include <tuple>
+#include <vector>
 
 enum class ParamType {
   Unknown, Knob, Slider, Button, Switch
@@ -25,6 +28,9 @@ struct ModuleStructureBundler : Bundler {
   static inline int32_t structureIdCounter = 0;
   int32_t id;
 
+  // forget every cached structure, e.g. when plugins may have been reloaded
+  static void clearCache();
+
   std::string pluginSlug, moduleSlug;
 
   typedef std::tuple<std::string, std::string, int> ParamTuple;
@@ -38,8 +44,30 @@ struct ModuleStructureBundler : Bundler {
 
   bool shouldLog{false};
 
+  // a structure message without its id, so one build can answer every
+  // later request for the same model
+  typedef std::function<void(osc::OutboundPacketStream&, int32_t /* structureId */)>
+    PartBuilder;
+  typedef std::pair<std::string /* path */, PartBuilder> Part;
+  std::vector<Part> parts;
+
+  // a new plugin version or panel theme can change the structure and its
+  // texture ids
+  typedef std::tuple<
+    std::string /* pluginSlug */,
+    std::string /* moduleSlug */,
+    std::string /* plugin version */,
+    bool /* darkPanels */
+  > CacheKey;
+  // one entry per model described this session. ui thread only.
+  static inline std::map<CacheKey, std::shared_ptr<const std::vector<Part>>> cache;
+
+  void addMessages(std::shared_ptr<const std::vector<Part>> structure);
+
   void addLightMessages(rack::app::ModuleWidget* moduleWidget);
   void addLightMessage(rack::app::LightWidget* lightWidget, int32_t paramId = -1);
   void addParamMessages(rack::app::ModuleWidget* moduleWidget);
   void addPortMessages(rack::app::ModuleWidget* moduleWidget);
+  // button/switch frames as a single strip texture
+  void addFramesMessage(int32_t paramId, int32_t numFrames, int64_t stripTextureId);
 };
@@ -0,0 +1,14 @@
+#include "OverlaySubscriptionAckBundler.hpp"
+
+OverlaySubscriptionAckBundler::OverlaySubscriptionAckBundler(
+    int64_t moduleId,
+    bool success
+) : Bundler("OverlaySubscriptionAckBundler") {
+  messages.emplace_back(
+    "/ack/subscribe/module/overlay",
+    [=](osc::OutboundPacketStream& pstream) {
+      pstream << moduleId
+        << success;
+    }
+  );
+}
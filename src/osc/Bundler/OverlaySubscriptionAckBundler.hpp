@@ -0,0 +1,7 @@
+#pragma once
+
+#include "Bundler.hpp"
+
+struct OverlaySubscriptionAckBundler : Bundler {
+  OverlaySubscriptionAckBundler(int64_t moduleId, bool success);
+};
@@ -1,12 +1,15 @@
 #include "ParamAckBundler.hpp"
 
-ParamAckBundler::ParamAckBundler(int64_t _moduleId, int32_t _paramId)
-  : Bundler("ParamAckBundler"), moduleId(_moduleId), paramId(_paramId) {}
+ParamAckBundler::ParamAckBundler(): Bundler("ParamAckBundler") {}
 
-ParamAckBundler* ParamAckBundler::success(float value) {
+ParamAckBundler* ParamAckBundler::success(
+  int64_t moduleId,
+  int32_t paramId,
+  float value
+) {
   messages.emplace_back(
     "/ack/param/value",
-    [&](osc::OutboundPacketStream& pstream) {
+    [=](osc::OutboundPacketStream& pstream) {
       pstream << moduleId
         << paramId
         << value
@@ -17,10 +20,10 @@ ParamAckBundler* ParamAckBundler::success(float value) {
   return this;
 }
 
-ParamAckBundler* ParamAckBundler::fail() {
+ParamAckBundler* ParamAckBundler::fail(int64_t moduleId, int32_t paramId) {
   messages.emplace_back(
     "/ack/param/value",
-    [&](osc::OutboundPacketStream& pstream) {
+    [=](osc::OutboundPacketStream& pstream) {
       pstream << moduleId
         << paramId
         << -1
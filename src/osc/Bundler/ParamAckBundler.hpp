@@ -2,12 +2,10 @@
 
 #include "Bundler.hpp"
 
+// /ack/param/value for every param applied in a frame, one bundle
 struct ParamAckBundler : Bundler {
-  ParamAckBundler(int64_t moduleId, int32_t paramId);
+  ParamAckBundler();
 
-  int64_t moduleId;
-  int32_t paramId;
-
-  ParamAckBundler* success(float value);
-  ParamAckBundler* fail();
+  ParamAckBundler* success(int64_t moduleId, int32_t paramId, float value);
+  ParamAckBundler* fail(int64_t moduleId, int32_t paramId);
 };
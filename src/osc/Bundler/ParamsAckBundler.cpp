@@ -0,0 +1,41 @@
+#include "ParamsAckBundler.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+ParamsAckBundler::ParamsAckBundler(
+  int32_t requestId,
+  const std::vector<Result>& results
+) : Bundler("ParamsAckBundler") {
+  int32_t total = results.size();
+  size_t perMessage = MAX_BLOB_SIZE / RECORD_SIZE;
+
+  // an empty batch still gets its ack
+  size_t first{0};
+  do {
+    size_t count = std::min(perMessage, results.size() - first);
+
+    auto records = std::make_shared<std::vector<uint8_t>>(count * RECORD_SIZE);
+    for (size_t i = 0; i < count; ++i) {
+      const Result& result = results[first + i];
+      uint8_t* out = records->data() + i * RECORD_SIZE;
+      std::memcpy(out, &result.moduleId, 8);
+      std::memcpy(out + 8, &result.paramId, 4);
+      std::memcpy(out + 12, &result.value, 4);
+    }
+
+    int32_t firstResult = first;
+    messages.emplace_back(
+      "/ack/params",
+      [=](osc::OutboundPacketStream& pstream) {
+        pstream << requestId
+          << firstResult
+          << total
+          << osc::Blob(records->data(), records->size());
+      }
+    );
+
+    first += count;
+  } while (first < results.size());
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Bundler.hpp"
+
+#include <vector>
+
+// a /set/params or /set/params/multi batch after it was applied, as few
+// /ack/params messages as fit it
+struct ParamsAckBundler : Bundler {
+  struct Result {
+    int64_t moduleId{-1};
+    int32_t paramId{-1};
+    // the value the param ended up at, NaN if it wasn't found
+    float value{0.f};
+  };
+
+  // record bytes per message
+  static const size_t MAX_BLOB_SIZE{1024};
+  // int64 moduleId, int32 paramId, float value
+  static const size_t RECORD_SIZE{16};
+
+  ParamsAckBundler(int32_t requestId, const std::vector<Result>& results);
+};
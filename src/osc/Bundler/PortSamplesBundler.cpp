@@ -0,0 +1,57 @@
+#include "PortSamplesBundler.hpp"
+#include "../PortTap.hpp"
+
+#include <algorithm>
+#include <memory>
+
+PortSamplesBundler::PortSamplesBundler(
+  int64_t moduleId,
+  int32_t portId,
+  bool isOutput,
+  int32_t sequence,
+  float sampleRate,
+  int32_t decimation,
+  bool envelope,
+  const std::vector<PortFrame>& frames
+) : Bundler("PortSamplesBundler") {
+  int32_t channels{0};
+  for (const PortFrame& frame : frames)
+    channels = std::max(channels, frame.channels);
+  if (channels == 0) return;
+
+  int32_t portType = isOutput ? 2 : 1;
+  size_t valuesPerFrame = channels * (envelope ? 2 : 1);
+  size_t framesPerMessage =
+    std::max((size_t)1, MAX_BLOB_SIZE / (valuesPerFrame * sizeof(float)));
+
+  for (size_t first = 0; first < frames.size(); first += framesPerMessage) {
+    size_t count = std::min(framesPerMessage, frames.size() - first);
+
+    // per frame, every channel's min then, for envelopes, every channel's max.
+    // channels a frame didn't have are 0.
+    auto values = std::make_shared<std::vector<float>>(count * valuesPerFrame, 0.f);
+    for (size_t i = 0; i < count; ++i) {
+      const PortFrame& frame = frames[first + i];
+      float* out = values->data() + i * valuesPerFrame;
+      std::copy_n(frame.min, frame.channels, out);
+      if (envelope) std::copy_n(frame.max, frame.channels, out + channels);
+    }
+
+    int32_t firstFrame = first;
+    messages.emplace_back(
+      "/port/samples",
+      [=](osc::OutboundPacketStream& pstream) {
+        pstream << moduleId
+          << portId
+          << portType
+          << sequence
+          << firstFrame
+          << sampleRate
+          << decimation
+          << envelope
+          << channels
+          << osc::Blob(values->data(), values->size() * sizeof(float));
+      }
+    );
+  }
+}
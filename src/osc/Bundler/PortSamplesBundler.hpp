@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Bundler.hpp"
+
+#include <vector>
+
+struct PortFrame;
+
+// drained /subscribe/port frames, split across /port/samples messages small
+// enough to share a packet
+struct PortSamplesBundler : Bundler {
+  // blob bytes per message
+  static const size_t MAX_BLOB_SIZE{1024};
+
+  PortSamplesBundler(
+    int64_t moduleId,
+    int32_t portId,
+    bool isOutput,
+    int32_t sequence,
+    float sampleRate,
+    int32_t decimation,
+    bool envelope,
+    const std::vector<PortFrame>& frames
+  );
+};
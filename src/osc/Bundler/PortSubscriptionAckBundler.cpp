@@ -0,0 +1,20 @@
+#include "PortSubscriptionAckBundler.hpp"
+
+PortSubscriptionAckBundler::PortSubscriptionAckBundler(
+    int64_t moduleId,
+    int32_t portId,
+    bool isOutput,
+    bool success
+) : Bundler("PortSubscriptionAckBundler") {
+  int32_t portType = isOutput ? 2 : 1;
+
+  messages.emplace_back(
+    "/ack/subscribe/port",
+    [=](osc::OutboundPacketStream& pstream) {
+      pstream << moduleId
+        << portId
+        << portType
+        << success;
+    }
+  );
+}
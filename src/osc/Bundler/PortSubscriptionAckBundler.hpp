@@ -0,0 +1,12 @@
+#pragma once
+
+#include "Bundler.hpp"
+
+struct PortSubscriptionAckBundler : Bundler {
+  PortSubscriptionAckBundler(
+    int64_t moduleId,
+    int32_t portId,
+    bool isOutput,
+    bool success
+  );
+};
@@ -0,0 +1,56 @@
+#include "TexturePreviewBundler.hpp"
+
+#include "qoi/qoi.h"
+
+#include <vector>
+
+TexturePreviewBundler::TexturePreviewBundler(
+  int64_t textureId,
+  const RenderResult& render
+): Bundler("TexturePreviewBundler") {
+  std::vector<uint8_t> encoded;
+  int32_t width{0}, height{0};
+
+  for (int factor = PREVIEW_FACTOR; ; factor *= 2) {
+    RenderResult preview = Renderer::downsampleBitmap(render, factor);
+
+    qoi_desc desc;
+    desc.width = preview.width;
+    desc.height = preview.height;
+    desc.channels = 4;
+    desc.colorspace = 0;
+
+    int length{0};
+    void* data = qoi_encode(preview.pixels.data(), &desc, &length);
+
+    if (!data) return;
+
+    bool fits = (size_t)length <= MAX_PREVIEW_BYTES;
+    bool smallest = preview.width == 1 && preview.height == 1;
+    if (fits || smallest) {
+      encoded.assign((uint8_t*)data, (uint8_t*)data + length);
+      width = preview.width;
+      height = preview.height;
+    }
+    free(data);
+
+    if (fits) break;
+    if (smallest) return;
+  }
+
+  int32_t fullWidth = render.width;
+  int32_t fullHeight = render.height;
+
+  messages.emplace_back(
+    "/set/texture/preview",
+    [=](osc::OutboundPacketStream& pstream) {
+      pstream << textureId
+        << width
+        << height
+        << fullWidth
+        << fullHeight
+        << osc::Blob(encoded.data(), encoded.size())
+        ;
+    }
+  );
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "Bundler.hpp"
+#include "../OscConstants.hpp"
+
+#include "../../texture/Renderer.hpp"
+
+// a small QOI encoded copy of a texture that fits in a single message
+struct TexturePreviewBundler : Bundler {
+  TexturePreviewBundler(int64_t textureId, const RenderResult& render);
+
+  // starting downscale, doubled until the preview fits
+  static const int PREVIEW_FACTOR{8};
+  // leaves room for the bundle, address and metadata
+  static const size_t MAX_PREVIEW_BYTES{MSG_BUFFER_SIZE - 128};
+};
@@ -0,0 +1,69 @@
+#include "CableIndex.hpp"
+
+#include <functional>
+
+size_t CableIndex::KeyHash::operator()(const Key& key) const {
+  size_t h = std::hash<int64_t>()(key.outputModuleId);
+  auto combine = [&h](size_t value) {
+    h ^= value + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+  };
+  combine(std::hash<int32_t>()(key.outputPortId));
+  combine(std::hash<int64_t>()(key.inputModuleId));
+  combine(std::hash<int32_t>()(key.inputPortId));
+  return h;
+}
+
+CableIndex::Key CableIndex::keyOf(const rack::engine::Cable* cable) {
+  return Key{
+    cable->outputModule->getId(),
+    cable->outputId,
+    cable->inputModule->getId(),
+    cable->inputId
+  };
+}
+
+int64_t CableIndex::find(const Key& key) {
+  if (stale || keys.size() != APP->engine->getNumCables()) rebuild();
+
+  auto it = cables.find(key);
+  if (it == cables.end()) return -1;
+
+  rack::engine::Cable* cable = APP->engine->getCable(it->second);
+  if (cable && keyOf(cable) == key) return it->second;
+
+  // removed and replaced in Rack since the last rebuild
+  rebuild();
+  it = cables.find(key);
+  return it == cables.end() ? -1 : it->second;
+}
+
+void CableIndex::add(const Key& key, int64_t cableId) {
+  cables[key] = cableId;
+  keys[cableId] = key;
+}
+
+void CableIndex::remove(int64_t cableId) {
+  auto it = keys.find(cableId);
+  if (it == keys.end()) return;
+
+  auto cable = cables.find(it->second);
+  if (cable != cables.end() && cable->second == cableId) cables.erase(cable);
+  keys.erase(it);
+}
+
+void CableIndex::invalidate() {
+  stale = true;
+}
+
+void CableIndex::rebuild() {
+  cables.clear();
+  keys.clear();
+
+  for (int64_t cableId : APP->engine->getCableIds()) {
+    rack::engine::Cable* cable = APP->engine->getCable(cableId);
+    if (!cable) continue;
+    add(keyOf(cable), cableId);
+  }
+
+  stale = false;
+}
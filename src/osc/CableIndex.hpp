@@ -0,0 +1,51 @@
+#pragma once
+
+#include "rack.hpp"
+
+#include <unordered_map>
+
+// engine cables by their ports, so checking for an existing cable doesn't
+// walk every cable in the patch. ui thread only.
+//
+// cables added or removed in Rack itself aren't reported to us. the index
+// rebuilds when the engine's cable count stops matching it or a hit turns
+// out to be stale, which catches everything short of an edit that keeps the
+// count and touches the same ports.
+struct CableIndex {
+  struct Key {
+    int64_t outputModuleId{-1};
+    int32_t outputPortId{-1};
+    int64_t inputModuleId{-1};
+    int32_t inputPortId{-1};
+
+    bool operator==(const Key& other) const {
+      return outputModuleId == other.outputModuleId
+        && outputPortId == other.outputPortId
+        && inputModuleId == other.inputModuleId
+        && inputPortId == other.inputPortId;
+    }
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+
+  static Key keyOf(const rack::engine::Cable* cable);
+
+  // id of the cable between these ports, -1 if there isn't one
+  int64_t find(const Key& key);
+
+  // record cables we added or removed, no rebuild needed
+  void add(const Key& key, int64_t cableId);
+  void remove(int64_t cableId);
+
+  // rebuild on the next find, e.g. after loading a patch
+  void invalidate();
+
+private:
+  std::unordered_map<Key, int64_t, KeyHash> cables;
+  std::unordered_map<int64_t, Key> keys;
+  bool stale{true};
+
+  void rebuild();
+};
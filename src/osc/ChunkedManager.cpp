@@ -50,6 +50,12 @@ bool ChunkedManager::chunkedExists(int64_t id) {
   return chunkedSends.count(id) != 0;
 }
 
+bool ChunkedManager::hasNormalPrioritySends() {
+  for (const auto& [id, chunked] : chunkedSends)
+    if (!chunked->lowPriority) return true;
+  return false;
+}
+
 bool ChunkedManager::deferredExists(int64_t id) {
   return deferredSends.count(id) != 0;
 }
@@ -80,8 +86,15 @@ void ChunkedManager::processChunked(int64_t id) {
     return;
   }
 
+  // low priority sends wait their turn, checking back with everything else
+  bool waiting =
+    chunkedSend->lowPriority
+      && chunkedSend->priorityWaits < ChunkedSend::MAX_PRIORITY_WAITS
+      && hasNormalPrioritySends();
+  if (waiting) ++chunkedSend->priorityWaits;
+
   std::vector<int32_t> unackedChunkNums;
-  chunkedSend->getUnackedChunkNums(unackedChunkNums);
+  if (!waiting) chunkedSend->getUnackedChunkNums(unackedChunkNums);
 
   for (int32_t chunkNum : unackedChunkNums) {
     ChunkedSendBundler* bundler =
@@ -26,6 +26,7 @@ private:
 
   std::map<int64_t, std::unique_ptr<ChunkedSend>> chunkedSends;
   bool chunkedExists(int64_t id);
+  bool hasNormalPrioritySends();
 
   void defer(ChunkedSend* chunked);
   std::map<int64_t, ChunkedSend*> deferredSends;
@@ -6,44 +6,119 @@
 #define QOI_IMPLEMENTATION
 #include "qoi/qoi.h"
 
-ChunkedImage::ChunkedImage(uint8_t* _pixels, int32_t _width, int32_t _height):
+ChunkedImage::ChunkedImage(
+  PixelBuffer _pixels,
+  int32_t _width,
+  int32_t _height
+):
   ChunkedSend(_pixels, _width * _height * ChunkedImage::DEPTH),
-  width(_width), height(_height) {}
+  width(_width),
+  height(_height),
+  originalWidth(_width),
+  originalHeight(_height) {}
 
 ChunkedImage::ChunkedImage(const RenderResult& result):
-  ChunkedImage(result.pixels, result.width, result.height) {}
+  ChunkedImage(result.pixels, result.width, result.height) {
+    offsetX = result.offsetX;
+    offsetY = result.offsetY;
+    originalWidth = result.originalWidth;
+    originalHeight = result.originalHeight;
+  }
+
+ChunkedImage::ChunkedImage(const EncodedTexture& texture):
+  ChunkedSend(texture.data, texture.size),
+  width(texture.width),
+  height(texture.height),
+  offsetX(texture.offsetX),
+  offsetY(texture.offsetY),
+  originalWidth(texture.originalWidth),
+  originalHeight(texture.originalHeight),
+  codec(texture.codec),
+  format(texture.format),
+  tint(texture.tint),
+  encoded(true) {}
+
+void ChunkedImage::encode() {
+  if (encoded) return;
+  encoded = true;
+
+  convertPixels();
 
-void ChunkedImage::init() {
   // TODO?: throw on compression failure, catch in caller and dispose
   bool compressionFailure = !compressData();
-  if (compressionFailure) WARN("failed to compress image data");
+  if (compressionFailure) {
+    WARN("failed to compress image data");
+    return;
+  }
 
+  if (cacheKey) TextureCache::put(*cacheKey, getEncoded());
+}
+
+EncodedTexture ChunkedImage::getEncoded() {
+  EncodedTexture texture;
+  texture.data = buffer;
+  texture.size = size;
+  texture.width = width;
+  texture.height = height;
+  texture.offsetX = offsetX;
+  texture.offsetY = offsetY;
+  texture.originalWidth = originalWidth;
+  texture.originalHeight = originalHeight;
+  texture.codec = codec;
+  texture.format = format;
+  texture.tint = tint;
+  return texture;
+}
+
+void ChunkedImage::init() {
+  encode();
   ChunkedSend::init();
 }
 
+void ChunkedImage::convertPixels() {
+  if (format == PixelFormat::RGBA8888) return;
+
+  PixelBuffer converted =
+    PixelFormat::convert(format, data, width, height, tint);
+
+  if (!converted) {
+    // INFO("image can't be %s, sending rgba8888", PixelFormat::name(format));
+    format = PixelFormat::RGBA8888;
+    return;
+  }
+
+  setData(converted, converted.size());
+}
+
 bool ChunkedImage::compressData() {
-  qoi_desc desc;
-  desc.width = width;
-  desc.height = height;
-  desc.channels = ChunkedImage::DEPTH;
-  desc.colorspace = 0;
+  if (codec == ImageCodec::DELTA) codec = ImageCodec::LZ4;
+  if (codec == ImageCodec::QOI && format != PixelFormat::RGBA8888)
+    codec = ImageCodec::LZ4;
 
-  int compressedLength{0};
-  void* compressedData = qoi_encode(data, &desc, &compressedLength);
+  // already raw, nothing to do
+  if (codec == ImageCodec::RAW) return true;
+
+  int64_t compressedLength{0};
+  PixelBuffer compressedData = ImageCodec::encode(
+    codec,
+    data,
+    width,
+    height,
+    PixelFormat::bytesPerPixel(format),
+    compressedLength
+  );
 
   if (!compressedData) return false;
 
   // INFO(
-  //   "image %d bytes, %d compressed",
-  //   width * height * ChunkedImage::DEPTH,
-  //   compressedLength
+  //   "image %lld bytes %s, %lld %s",
+  //   size,
+  //   PixelFormat::name(format),
+  //   compressedLength,
+  //   ImageCodec::name(codec)
   // );
 
-  delete[] data;
-  data = new uint8_t[compressedLength];
-  size = compressedLength;
-  memcpy(data, compressedData, size);
-  free(compressedData);
+  setData(compressedData, compressedLength);
 
   return true;
 }
@@ -63,6 +138,13 @@ ChunkedSendBundler* ChunkedImage::getBundlerForChunk(int32_t chunkNum) {
     data,
     thisChunkSize,
     width,
-    height
+    height,
+    offsetX,
+    offsetY,
+    originalWidth,
+    originalHeight,
+    codec,
+    format,
+    tint
   );
 }
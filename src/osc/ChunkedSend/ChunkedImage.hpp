@@ -3,18 +3,50 @@
 #include "ChunkedSend.hpp"
 
 #include "../../texture/Renderer.hpp"
+#include "../../texture/ImageCodec.hpp"
+#include "../../texture/PixelFormat.hpp"
+#include "../../texture/TextureCache.hpp"
+
+#include <optional>
 
 struct ChunkedImage : ChunkedSend {
-  ChunkedImage(uint8_t* _pixels, int32_t _width, int32_t _height);
+  ChunkedImage(PixelBuffer _pixels, int32_t _width, int32_t _height);
   ChunkedImage(const RenderResult& result);
+  // already converted and encoded, sent as is
+  ChunkedImage(const EncodedTexture& encoded);
 
   static const int32_t DEPTH{4};
   int32_t width;
   int32_t height;
 
+  // where a trimmed image sits within the full render
+  int32_t offsetX{0};
+  int32_t offsetY{0};
+  int32_t originalWidth;
+  int32_t originalHeight;
+
+  // DELTA has no previous frame here and is sent as LZ4
+  ImageCodec::Id codec{ImageCodec::QOI};
+
+  // converted to before encoding, RGBA8888 if the image doesn't fit it.
+  // QOI only encodes RGBA8888, other formats are sent as LZ4.
+  PixelFormat::Id format{PixelFormat::RGBA8888};
+  // A8's color, RGBA byte order
+  uint32_t tint{0};
+
+  // set to keep the encoded result in TextureCache
+  std::optional<TextureCacheKey> cacheKey;
+
   ChunkedSendBundler* getBundlerForChunk(int32_t chunkNum) override;
 
+  // convert and compress, once. init does this if it hasn't been done.
+  void encode();
+  // the payload as it stands, for TextureCache
+  EncodedTexture getEncoded();
   void init() override;
 private:
+  bool encoded{false};
+
+  void convertPixels();
   bool compressData();
 };
@@ -0,0 +1,95 @@
+#include "ChunkedOverlayFrame.hpp"
+
+#include "../Bundler/ChunkedOverlayFrameBundler.hpp"
+#include "../../texture/TileDiff.hpp"
+
+ChunkedOverlayFrame::ChunkedOverlayFrame(
+  int64_t _moduleId,
+  int32_t _frameNum,
+  int32_t _width,
+  int32_t _height,
+  bool _keyframe,
+  const std::vector<uint32_t>& _tiles,
+  PixelBuffer strip,
+  ImageCodec::Id _codec,
+  PixelBuffer _previousStrip
+): ChunkedSend(
+    strip,
+    TileDiff::TILE_SIZE * TileDiff::TILE_SIZE * 4 * _tiles.size()
+  ),
+  moduleId(_moduleId),
+  frameNum(_frameNum),
+  width(_width),
+  height(_height),
+  keyframe(_keyframe),
+  tiles(_tiles),
+  codec(_codec),
+  previousStrip(_previousStrip) {}
+
+void ChunkedOverlayFrame::init() {
+  if (!encodePayload()) WARN("failed to encode overlay frame");
+
+  ChunkedSend::init();
+}
+
+bool ChunkedOverlayFrame::encodePayload() {
+  if (codec == ImageCodec::DELTA && !previousStrip) codec = ImageCodec::LZ4;
+
+  int64_t compressedLength{0};
+  PixelBuffer compressedData = ImageCodec::encode(
+    codec,
+    data,
+    TileDiff::TILE_SIZE,
+    TileDiff::TILE_SIZE * tiles.size(),
+    4,
+    compressedLength,
+    previousStrip.data()
+  );
+  previousStrip.reset();
+
+  if (!compressedData) return false;
+
+  int64_t tableSize = 4 * (tiles.size() + 1);
+  PixelBuffer payload(tableSize + compressedLength);
+  uint8_t* dst = payload.data();
+
+  // little-endian uint32 tile count, then each tile index
+  auto writeU32 = [](uint8_t* dst, uint32_t value) {
+    dst[0] = value & 0xFF;
+    dst[1] = (value >> 8) & 0xFF;
+    dst[2] = (value >> 16) & 0xFF;
+    dst[3] = (value >> 24) & 0xFF;
+  };
+  writeU32(dst, tiles.size());
+  for (size_t i = 0; i < tiles.size(); ++i)
+    writeU32(dst + 4 * (i + 1), tiles[i]);
+
+  memcpy(dst + tableSize, compressedData.data(), compressedLength);
+
+  setData(payload, tableSize + compressedLength);
+
+  return true;
+}
+
+ChunkedSendBundler* ChunkedOverlayFrame::getBundlerForChunk(int32_t chunkNum) {
+  int32_t thisChunkSize =
+    chunkNum == numChunks - 1
+      ? size - (numChunks - 1) * chunkSize
+      : chunkSize;
+
+  return new ChunkedOverlayFrameBundler(
+    id,
+    chunkNum,
+    numChunks,
+    chunkSize,
+    size,
+    data,
+    thisChunkSize,
+    moduleId,
+    frameNum,
+    width,
+    height,
+    keyframe,
+    codec
+  );
+}
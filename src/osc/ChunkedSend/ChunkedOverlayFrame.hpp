@@ -0,0 +1,41 @@
+#pragma once
+
+#include "ChunkedSend.hpp"
+
+#include "../../texture/ImageCodec.hpp"
+
+#include <vector>
+
+// the changed tiles of one overlay frame, see /subscribe/module/overlay
+struct ChunkedOverlayFrame : ChunkedSend {
+  ChunkedOverlayFrame(
+    int64_t _moduleId,
+    int32_t _frameNum,
+    int32_t _width,
+    int32_t _height,
+    bool _keyframe,
+    const std::vector<uint32_t>& _tiles,
+    PixelBuffer strip,
+    ImageCodec::Id _codec = ImageCodec::QOI,
+    PixelBuffer _previousStrip = PixelBuffer()
+  );
+
+  int64_t moduleId;
+  int32_t frameNum;
+  int32_t width;
+  int32_t height;
+  bool keyframe;
+  std::vector<uint32_t> tiles;
+  ImageCodec::Id codec;
+
+  // the same tiles from the last frame sent, what DELTA is taken against.
+  // keyframes go without and DELTA falls back to LZ4.
+  PixelBuffer previousStrip;
+
+  ChunkedSendBundler* getBundlerForChunk(int32_t chunkNum) override;
+
+  void init() override;
+private:
+  // tile table followed by the encoded strip
+  bool encodePayload();
+};
@@ -0,0 +1,38 @@
+#include "ChunkedPanelVector.hpp"
+
+#include "../Bundler/ChunkedPanelVectorBundler.hpp"
+
+#include <cstring>
+
+ChunkedPanelVector::ChunkedPanelVector(
+  const std::string& _pluginSlug,
+  const std::string& _moduleSlug,
+  const PanelVectorResult& result
+): ChunkedSend(PixelBuffer(result.data.size()), result.data.size()),
+  pluginSlug(_pluginSlug),
+  moduleSlug(_moduleSlug),
+  width(result.width),
+  height(result.height) {
+    std::memcpy(data, result.data.data(), size);
+  }
+
+ChunkedSendBundler* ChunkedPanelVector::getBundlerForChunk(int32_t chunkNum) {
+  int32_t thisChunkSize =
+    chunkNum == numChunks - 1
+      ? size - (numChunks - 1) * chunkSize
+      : chunkSize;
+
+  return new ChunkedPanelVectorBundler(
+    id,
+    chunkNum,
+    numChunks,
+    chunkSize,
+    size,
+    data,
+    thisChunkSize,
+    pluginSlug,
+    moduleSlug,
+    width,
+    height
+  );
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "ChunkedSend.hpp"
+
+#include "../../texture/PanelVector.hpp"
+
+struct ChunkedPanelVector : ChunkedSend {
+  ChunkedPanelVector(
+    const std::string& _pluginSlug,
+    const std::string& _moduleSlug,
+    const PanelVectorResult& result
+  );
+
+  std::string pluginSlug;
+  std::string moduleSlug;
+  float width;
+  float height;
+
+  ChunkedSendBundler* getBundlerForChunk(int32_t chunkNum) override;
+};
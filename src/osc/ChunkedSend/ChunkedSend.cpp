@@ -2,8 +2,14 @@
 
 #include "../Bundler/ChunkedSendBundler.hpp"
 
-ChunkedSend::ChunkedSend(uint8_t* _data, int64_t _size):
-  id(idCounter++), data(_data), size(_size) {}
+ChunkedSend::ChunkedSend(PixelBuffer _buffer, int64_t _size):
+  id(idCounter++), buffer(_buffer), data(_buffer.data()), size(_size) {}
+
+void ChunkedSend::setData(PixelBuffer _buffer, int64_t _size) {
+  buffer = _buffer;
+  data = buffer.data();
+  size = _size;
+}
 
 
 void ChunkedSend::init() {
@@ -18,7 +24,6 @@ void ChunkedSend::init() {
 
 ChunkedSend::~ChunkedSend() {
   // logCompletionDuration();
-  delete[] data;
 }
 
 void ChunkedSend::ack(int32_t chunkNum) {
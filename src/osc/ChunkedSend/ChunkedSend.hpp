@@ -3,6 +3,7 @@
 #include "rack.hpp"
 
 #include "../OscSender.hpp"
+#include "../../util/BufferPool.hpp"
 
 #include <map>
 #include <mutex>
@@ -15,7 +16,7 @@ class ChunkedSendBundler;
 struct ChunkedSend {
   inline static int64_t idCounter{0};
 
-  ChunkedSend(uint8_t* _data, int64_t _size);
+  ChunkedSend(PixelBuffer _buffer, int64_t _size);
   virtual ~ChunkedSend();
 
   virtual void init();
@@ -30,9 +31,19 @@ struct ChunkedSend {
   bool sendFailed();
   bool sendSucceeded();
 
+  // held back while any normal priority send is in progress, for at most
+  // MAX_PRIORITY_WAITS retry rounds so a steady stream can't starve it
+  bool lowPriority{false};
+  static const uint8_t MAX_PRIORITY_WAITS = 10;
+  uint8_t priorityWaits{0};
+
   int64_t id;
+  // owns data, which bundlers read chunks from
+  PixelBuffer buffer;
   uint8_t* data;
   int64_t size;
+  // swap in an encoded payload
+  void setData(PixelBuffer _buffer, int64_t _size);
   int32_t numChunks{0};
   int32_t chunkSize{0};
 
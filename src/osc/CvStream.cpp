@@ -0,0 +1,99 @@
+#include "CvStream.hpp"
+
+bool CvStream::push(const CvFrame& frame) {
+  if (ring.push(frame)) return true;
+
+  ++overruns;
+  return false;
+}
+
+bool CvStream::advance() {
+  CvFrame next;
+  if (!ring.pop(next)) return false;
+
+  history[0] = history[1];
+  history[1] = history[2];
+  history[2] = history[3];
+  history[3] = next;
+  return true;
+}
+
+size_t CvStream::targetFrames(float rate) const {
+  return std::min((size_t)(targetDepth * rate), MAX_TARGET_FRAMES);
+}
+
+int32_t CvStream::process(float engineSampleRate, float* voltages) {
+  int32_t numChannels = channels.load(std::memory_order_relaxed);
+  float rate = sampleRate.load(std::memory_order_relaxed);
+  if (numChannels <= 0 || rate <= 0.f) return 0;
+
+  if (!playing) {
+    // wait for the buffer to fill, holding the last frame played
+    if (ring.size() < targetFrames(rate) + 3) {
+      std::copy_n(history[2].voltages, numChannels, voltages);
+      return numChannels;
+    }
+
+    // prime the history so playback starts on a real frame
+    advance();
+    advance();
+    advance();
+    history[0] = history[1];
+    phase = 0.0;
+    playing = true;
+  }
+
+  phase += rate / engineSampleRate;
+  while (phase >= 1.0) {
+    if (!advance()) {
+      ++underruns;
+      targetDepth = std::min(MAX_DEPTH, targetDepth * 1.5f);
+      depth = targetDepth;
+      stableTime = 0.f;
+      playing = false;
+      // hold the newest frame
+      phase = 1.0;
+      break;
+    }
+    phase -= 1.0;
+  }
+
+  // nothing ran dry for a while, try a shallower buffer
+  stableTime += 1.f / engineSampleRate;
+  if (stableTime > SHRINK_AFTER) {
+    targetDepth = std::max(MIN_DEPTH, targetDepth * 0.8f);
+    depth = targetDepth;
+    stableTime = 0.f;
+  }
+
+  // the sender is running ahead, skip back down to the target latency
+  size_t target = targetFrames(rate);
+  if (ring.size() > std::min(target * 3 + 3, CAPACITY * 3 / 4)) {
+    ++overruns;
+    while (ring.size() > target) advance();
+  }
+
+  float t = phase;
+  const float* p0 = history[0].voltages;
+  const float* p1 = history[1].voltages;
+  const float* p2 = history[2].voltages;
+  const float* p3 = history[3].voltages;
+
+  if (!playing || interpolation.load(std::memory_order_relaxed) != CUBIC) {
+    for (int32_t c = 0; c < numChannels; ++c)
+      voltages[c] = p1[c] + (p2[c] - p1[c]) * t;
+    return numChannels;
+  }
+
+  // catmull-rom
+  for (int32_t c = 0; c < numChannels; ++c) {
+    voltages[c] = p1[c] + 0.5f * t * (
+      p2[c] - p0[c] + t * (
+        2.f * p0[c] - 5.f * p1[c] + 4.f * p2[c] - p3[c] + t * (
+          3.f * (p1[c] - p2[c]) + p3[c] - p0[c]
+        )
+      )
+    );
+  }
+  return numChannels;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "rack.hpp"
+
+#include <atomic>
+
+#include "../util/SpscRing.hpp"
+
+// one frame of a /stream/cv stream, a voltage per channel
+struct CvFrame {
+  float voltages[rack::engine::PORT_MAX_CHANNELS]{};
+};
+
+// samples from /stream/cv on their way to one of OSCctrl's outputs. a jitter
+// buffer that grows when it runs dry and shrinks while it doesn't, played
+// back at the engine sample rate.
+struct CvStream {
+  enum Interpolation : int32_t {
+    LINEAR = 0,
+    CUBIC = 1,
+  };
+
+  // frames, a little over 80ms at 48kHz
+  static const size_t CAPACITY{4096};
+  // most frames the jitter buffer aims to hold, so high stream rates still
+  // leave the ring room to fill past the target
+  static const size_t MAX_TARGET_FRAMES{CAPACITY / 2};
+
+  // jitter buffer depth, seconds
+  static constexpr float MIN_DEPTH{0.002f};
+  static constexpr float START_DEPTH{0.01f};
+  static constexpr float MAX_DEPTH{0.08f};
+  // seconds without an underrun before the depth comes down
+  static constexpr float SHRINK_AFTER{5.f};
+
+  // receiver thread, set with each blob
+  std::atomic<int32_t> channels{0};
+  std::atomic<float> sampleRate{0.f};
+  std::atomic<int32_t> interpolation{LINEAR};
+
+  // receiver thread. false if the frame didn't fit.
+  bool push(const CvFrame& frame);
+
+  // audio thread. fills voltages with this sample's frame, returns the
+  // number of channels.
+  int32_t process(float engineSampleRate, float* voltages);
+
+  // since the patch loaded, read from any thread
+  std::atomic<uint32_t> underruns{0};
+  std::atomic<uint32_t> overruns{0};
+  // current jitter buffer depth, seconds
+  std::atomic<float> depth{START_DEPTH};
+  size_t buffered() const { return ring.size(); }
+
+private:
+  SpscRing<CvFrame, CAPACITY> ring;
+
+  // audio thread only. playback is between history[1] and history[2],
+  // the outer two are for cubic interpolation.
+  CvFrame history[4];
+  double phase{0.0};
+  bool playing{false};
+  float targetDepth{START_DEPTH};
+  float stableTime{0.f};
+
+  // shift the next frame into history, false if there isn't one
+  bool advance();
+  // targetDepth in frames at this rate, capped to fit the ring
+  size_t targetFrames(float rate) const;
+};
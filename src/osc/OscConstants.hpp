@@ -9,3 +9,11 @@
 
 #define MAX_MISSED_HEARTBEATS 5
 #define HEARTBEAT_INTERVAL_MS 1000 // ms between heartbeats
+
+// /get/texture request flags
+#define TEXTURE_FLAG_TRIM (1 << 0) // crop transparent borders
+#define TEXTURE_FLAG_PROGRESSIVE (1 << 1) // preview first, then the full texture at low priority
+
+// OSC timetags are NTP time, seconds since 1900
+#define OSC_TIMETAG_IMMEDIATE 1
+#define OSC_NTP_UNIX_OFFSET 2208988800.0 // seconds from 1900 to 1970
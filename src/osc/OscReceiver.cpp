@@ -3,14 +3,18 @@
 #include "rack.hpp"
 #include "patch.hpp"
 
+#include <cstring>
+
 #include "OscReceiver.hpp"
 
 #include "../OSCctrl.hpp"
 #include "OscSender.hpp"
 #include "ChunkedManager.hpp"
 #include "SubscriptionManager.hpp"
+#include "../util/WorkerPool.hpp"
 
 #include "ChunkedSend/ChunkedImage.hpp"
+#include "ChunkedSend/ChunkedPanelVector.hpp"
 
 #include "Bundler/PatchInfoBundler.hpp"
 #include "Bundler/ModuleStubsBundler.hpp"
@@ -18,13 +22,24 @@
 #include "Bundler/ModuleStateBundler.hpp"
 #include "Bundler/ModuleParamsBundler.hpp"
 #include "Bundler/CablesBundler.hpp"
+#include "Bundler/ModuleAtlasBundler.hpp"
 
 #include "Bundler/CableAckBundler.hpp"
+#include "Bundler/CableBatchAckBundler.hpp"
 #include "Bundler/ParamAckBundler.hpp"
 #include "Bundler/LightSubscriptionAckBundler.hpp"
+#include "Bundler/OverlaySubscriptionAckBundler.hpp"
+#include "Bundler/PortSubscriptionAckBundler.hpp"
+#include "Bundler/TexturePreviewBundler.hpp"
+#include "Bundler/CvStreamStatsBundler.hpp"
+#include "Bundler/ActionStatsBundler.hpp"
 
 #include "../texture/Catalog.hpp"
 #include "../texture/Renderer.hpp"
+#include "../texture/Atlas.hpp"
+#include "../texture/OverlayContext.hpp"
+#include "../texture/PanelVector.hpp"
+#include "../texture/SvgRasterizer.hpp"
 
 OscReceiver::OscReceiver(
   OSCctrlWidget* _ctrl,
@@ -47,8 +62,13 @@ OscReceiver::~OscReceiver() {
 
 void OscReceiver::startListener() {
   try {
+#ifdef ARCH_LIN
+    rxSocket = new BatchListener(endpoint, this);
+    listenerThread = std::thread(&BatchListener::Run, rxSocket);
+#else
     rxSocket = new UdpListeningReceiveSocket(endpoint, this);
     listenerThread = std::thread(&UdpListeningReceiveSocket::Run, rxSocket);
+#endif
   } catch (const std::runtime_error& e) {
     if (activePort >= RX_PORT + maxBindRetries) {
       WARN("failed to start OSC receiver after %d attempts", maxBindRetries);
@@ -100,6 +120,9 @@ void OscReceiver::startHeartbeat() {
       osctx->setBroadcasting();
 
       subman->reset();
+      textureCodec = ImageCodec::QOI;
+      directParamWrites = false;
+      dynamic_cast<OSCctrl*>(ctrl->module)->paramScheduler.lateEvents = 0;
     }
   });
 
@@ -114,11 +137,11 @@ void OscReceiver::ProcessMessage(
 
   // TODO: bail early if we're still broadcasting
   try {
-    std::string address = message.AddressPattern();
-    if (!routes.count(address)) throw osc::Exception("no route for address");
+    const RouteTable::Handler* route = routes.find(message.AddressPattern());
+    if (!route) throw osc::Exception("no route for address");
 
     osc::ReceivedMessage::const_iterator argsIterator = message.ArgumentsBegin();
-    routes.at(address)(argsIterator, remoteEndpoint);
+    (*route)(argsIterator, remoteEndpoint);
 
     if (argsIterator != message.ArgumentsEnd())
       throw osc::ExcessArgumentException();
@@ -127,6 +150,56 @@ void OscReceiver::ProcessMessage(
   }
 }
 
+void OscReceiver::ProcessBundle(
+  const osc::ReceivedBundle& bundle,
+  const IpEndpointName& remoteEndpoint
+) {
+  for (auto element = bundle.ElementsBegin(); element != bundle.ElementsEnd(); ++element) {
+    if (element->IsBundle()) {
+      ProcessBundle(osc::ReceivedBundle(*element), remoteEndpoint);
+      continue;
+    }
+
+    osc::ReceivedMessage message(*element);
+    if (bundle.TimeTag() != OSC_TIMETAG_IMMEDIATE
+      && std::strcmp(message.AddressPattern(), "/set/param/value") == 0) {
+      try {
+        if (scheduleParamWrite(message, bundle.TimeTag())) continue;
+      } catch (osc::Exception& e) {
+        WARN("error parsing OSC message %s: %s", message.AddressPattern(), e.what());
+        continue;
+      }
+    }
+
+    ProcessMessage(message, remoteEndpoint);
+  }
+}
+
+bool OscReceiver::scheduleParamWrite(
+  const osc::ReceivedMessage& message,
+  uint64_t timeTag
+) {
+  // a bypassed OSCctrl isn't processed
+  OSCctrl* module = dynamic_cast<OSCctrl*>(ctrl->module);
+  if (module->isBypassed()) return false;
+
+  osc::ReceivedMessage::const_iterator args = message.ArgumentsBegin();
+  DirectParamWrite write;
+  write.moduleId = (args++)->AsInt64();
+  write.paramId = (args++)->AsInt32();
+  write.value = (args++)->AsFloat();
+  write.needsAck = (args++)->AsBool();
+  if (args != message.ArgumentsEnd()) throw osc::ExcessArgumentException();
+
+  // ntp seconds since 1900 with a 32 bit fraction, moved onto Rack's clock
+  double unixTime = (double)(timeTag >> 32) - OSC_NTP_UNIX_OFFSET
+    + (double)(timeTag & 0xFFFFFFFF) / 4294967296.0;
+  double time =
+    rack::system::getTime() + (unixTime - rack::system::getUnixTime());
+
+  return module->paramScheduler.schedule(time, write);
+}
+
 void OscReceiver::generateRoutes() {
   routes.emplace(
     "/register",
@@ -161,6 +234,23 @@ void OscReceiver::generateRoutes() {
     }
   );
 
+  routes.emplace(
+    "/get/action_stats",
+    [&](osc::ReceivedMessage::const_iterator& args, const IpEndpointName&) {
+      ctrl->enqueueAction([this]() {
+        OSCctrlWidget::ActionStats& stats = ctrl->actionStats;
+        osctx->enqueueBundler(new ActionStatsBundler(
+          ctrl->getActionQueueDepth(),
+          stats.executed,
+          stats.totalTime,
+          stats.maxTime,
+          stats.carriedOver
+        ));
+        stats = OSCctrlWidget::ActionStats();
+      });
+    }
+  );
+
   routes.emplace(
     "/get/patch_info",
     [&](osc::ReceivedMessage::const_iterator& args, const IpEndpointName&) {
@@ -233,10 +323,16 @@ void OscReceiver::generateRoutes() {
       // 1st: int32 height
       // 2nd: int32 width
       // 3rd: bool ensureEnqueue
+      //
+      // any of which may be followed by int32 flags, after ensureEnqueue,
+      // then int32 codec, then int32 pixel format
 
       float scale{-1.f};
       int32_t height{-1}, width{-1};
       bool ensureEnqueue{false};
+      int32_t flags{0};
+      int32_t codec = textureCodec;
+      int32_t format{PixelFormat::RGBA8888};
 
       // 1. float or int32 (height)
       if (args->IsFloat()) {
@@ -252,21 +348,45 @@ void OscReceiver::generateRoutes() {
       }
       ++args;
 
-      // 2. bool or int32 (width)
-      try {
-        if (args->IsBool()) {
-          ensureEnqueue = args->AsBool();
-        } else if (args->IsInt32()) {
-          width = args->AsInt32();
-        }
+      // 2. int32 (width)
+      if (args->IsInt32()) {
+        width = args->AsInt32();
         ++args;
-      } catch (const osc::WrongArgumentTypeException& e) {}
+      }
 
       // 3. bool
-      try {
+      if (args->IsBool()) {
         ensureEnqueue = args->AsBool();
-      } catch (const osc::WrongArgumentTypeException& e) {}
-      ++args;
+        ++args;
+
+        // 4. int32 (flags)
+        if (args->IsInt32()) {
+          flags = args->AsInt32();
+          ++args;
+
+          // 5. int32 (codec)
+          if (args->IsInt32()) {
+            codec = args->AsInt32();
+            ++args;
+
+            // 6. int32 (pixel format)
+            if (args->IsInt32()) {
+              format = args->AsInt32();
+              ++args;
+            }
+          }
+        }
+      }
+
+      if (!ImageCodec::isValid(codec)) {
+        INFO("/get/texture %ld unknown codec %d", textureId, codec);
+        return;
+      }
+
+      if (!PixelFormat::isValid(format)) {
+        INFO("/get/texture %ld unknown pixel format %d", textureId, format);
+        return;
+      }
 
       ctrl->enqueueAction([=, this]() {
         Recipe recipe;
@@ -277,22 +397,192 @@ void OscReceiver::generateRoutes() {
         } else {
           recipe = Recipe(height);
         }
+        recipe.trim = flags & TEXTURE_FLAG_TRIM;
+        recipe.format = (PixelFormat::Id)format;
+
+        // already encoded, no preview needed
+        if (sendCachedTexture(
+          textureId,
+          recipe,
+          (ImageCodec::Id)codec,
+          ensureEnqueue
+        )) return;
+
+        // plain svgs don't need the GL context, draw them on the pool
+        RasterJob job;
+        if (Catalog::prepareRaster(textureId, recipe, job)) {
+          ctrl->rasterPool->enqueue([=, this]() {
+            RenderResult render = SvgRasterizer::render(job);
+
+            ctrl->enqueueAction([=, this]() {
+              sendTexture(
+                textureId,
+                render,
+                ensureEnqueue,
+                flags,
+                (ImageCodec::Id)codec,
+                recipe
+              );
+            });
+          });
+          return;
+        }
+
+        RenderResult render = Catalog::pullTexture(textureId, recipe);
+        sendTexture(
+          textureId,
+          render,
+          ensureEnqueue,
+          flags,
+          (ImageCodec::Id)codec,
+          recipe
+        );
+      });
+    }
+  );
+
+  routes.emplace(
+    "/get/texture/region",
+    [&](osc::ReceivedMessage::const_iterator& args, const IpEndpointName&) {
+      int64_t textureId = (args++)->AsInt64();
+      int64_t requestId = (args++)->AsInt64();
+      // cm from the widget's top left
+      float x = (args++)->AsFloat();
+      float y = (args++)->AsFloat();
+      float regionWidth = (args++)->AsFloat();
+      float regionHeight = (args++)->AsFloat();
+
+      float scale{-1.f};
+      int32_t height{-1};
+      bool ensureEnqueue{false};
+
+      if (args->IsFloat()) {
+        scale = args->AsFloat();
+      } else if (args->IsInt32()) {
+        height = args->AsInt32();
+      } else {
+        INFO(
+          "/get/texture/region %ld scale (float) or height (int32) param was neither",
+          textureId
+        );
+        return;
+      }
+      ++args;
+
+      if (args->IsBool()) ensureEnqueue = (args++)->AsBool();
+
+      if (regionWidth <= 0.f || regionHeight <= 0.f) {
+        INFO("/get/texture/region %ld empty region", textureId);
+        return;
+      }
+      if (requestId < 0) {
+        INFO("/get/texture/region %ld negative request id %ld", textureId, requestId);
+        return;
+      }
+
+      // other chunked sends use texture ids and ChunkedSend::idCounter, both
+      // positive, so regions get the negative ids
+      int64_t chunkedSendId = -1 - requestId;
+
+      ImageCodec::Id codec = (ImageCodec::Id)textureCodec.load();
+
+      ctrl->enqueueAction([=, this]() {
+        Recipe recipe = scale > 0.f ? Recipe(scale) : Recipe(height);
+        recipe.region = rack::math::Rect(x, y, regionWidth, regionHeight);
 
         RenderResult render = Catalog::pullTexture(textureId, recipe);
+        sendTexture(
+          chunkedSendId,
+          render,
+          ensureEnqueue,
+          0,
+          codec,
+          recipe
+        );
+      });
+    }
+  );
+
+  routes.emplace(
+    "/get/module_atlas",
+    [&](osc::ReceivedMessage::const_iterator& args, const IpEndpointName&) {
+      std::string pluginSlug = (args++)->AsString();
+      std::string moduleSlug = (args++)->AsString();
+
+      // 1st: float scale or int32 panel height
+      // 2nd (optional): bool ensureEnqueue
+      float scale{-1.f};
+      int32_t height{-1};
+      bool ensureEnqueue{false};
+
+      if (args->IsFloat()) {
+        scale = args->AsFloat();
+      } else if (args->IsInt32()) {
+        height = args->AsInt32();
+      } else {
+        INFO(
+          "/get/module_atlas %s:%s scale (float) or height (int32) param was neither",
+          pluginSlug.c_str(),
+          moduleSlug.c_str()
+        );
+        return;
+      }
+      ++args;
 
-        if (render.failure()) {
-          INFO("failed to render texture %lld", textureId);
-          INFO("  %s", render.statusMessage.c_str());
+      try {
+        ensureEnqueue = args->AsBool();
+        ++args;
+      } catch (const osc::WrongArgumentTypeException& e) {}
+
+      ImageCodec::Id codec = (ImageCodec::Id)textureCodec.load();
+
+      ctrl->enqueueAction([=, this]() {
+        Recipe recipe = scale > 0.f ? Recipe(scale) : Recipe(height);
+
+        AtlasResult atlas = Atlas::build(pluginSlug, moduleSlug, recipe);
+
+        if (!atlas.render.success()) {
+          INFO("failed to build atlas for %s:%s", pluginSlug.c_str(), moduleSlug.c_str());
+          if (atlas.render.failure())
+            INFO("  %s", atlas.render.statusMessage.c_str());
           return;
         }
 
-        ChunkedImage* chunkedImage = new ChunkedImage(render);
-        chunkedImage->id = textureId;
+        int64_t atlasId = Catalog::pullAtlasId(pluginSlug, moduleSlug);
+
+        // uv table goes out ahead of the first chunk
+        osctx->enqueueBundler(
+          new ModuleAtlasBundler(atlasId, pluginSlug, moduleSlug, atlas)
+        );
+
+        ChunkedImage* chunkedImage = new ChunkedImage(atlas.render);
+        chunkedImage->id = atlasId;
+        chunkedImage->codec = codec;
         chunkman->add(chunkedImage, ensureEnqueue);
       });
     }
   );
 
+  routes.emplace(
+    "/get/panel_vector",
+    [&](osc::ReceivedMessage::const_iterator& args, const IpEndpointName&) {
+      std::string pluginSlug = (args++)->AsString();
+      std::string moduleSlug = (args++)->AsString();
+
+      ctrl->enqueueAction([=, this]() {
+        PanelVectorResult panelVector = PanelVector::build(pluginSlug, moduleSlug);
+
+        if (panelVector.failure()) {
+          INFO("failed to serialize panel for %s:%s", pluginSlug.c_str(), moduleSlug.c_str());
+          INFO("  %s", panelVector.statusMessage.c_str());
+          return;
+        }
+
+        chunkman->add(new ChunkedPanelVector(pluginSlug, moduleSlug, panelVector));
+      });
+    }
+  );
+
   // state
   routes.emplace(
     "/get/module_state",
@@ -337,6 +627,95 @@ void OscReceiver::generateRoutes() {
     }
   );
 
+  routes.emplace(
+    "/subscribe/port",
+    [&](osc::ReceivedMessage::const_iterator& args, const IpEndpointName&) {
+      int64_t moduleId = (args++)->AsInt64();
+      int32_t portId = (args++)->AsInt32();
+      int32_t decimation = (args++)->AsInt32();
+
+      // optional port type, 1 = input, 2 = output (default)
+      int32_t portType{2};
+      if (args->IsInt32()) portType = (args++)->AsInt32();
+
+      // optional min/max envelope of each decimation window
+      bool envelope{false};
+      if (args->IsBool()) envelope = (args++)->AsBool();
+
+      if (portType != 1 && portType != 2) {
+        INFO("/subscribe/port %ld unknown port type %d", moduleId, portType);
+        return;
+      }
+      bool isOutput = portType == 2;
+
+      ctrl->enqueueAction([=, this]() {
+        bool success = subman->subscribePort(
+          moduleId,
+          portId,
+          isOutput,
+          decimation,
+          envelope
+        );
+        osctx->enqueueBundler(
+          new PortSubscriptionAckBundler(moduleId, portId, isOutput, success)
+        );
+      });
+    }
+  );
+
+  routes.emplace(
+    "/subscribe/module/overlay",
+    [&](osc::ReceivedMessage::const_iterator& args, const IpEndpointName&) {
+      int64_t moduleId = (args++)->AsInt64();
+      float fps = (args++)->AsFloat();
+
+      // optional float scale or int32 height, defaults to 1:1,
+      // then optional int32 codec
+      float scale{1.f};
+      int32_t height{-1};
+      int32_t codec = textureCodec;
+      if (args->IsFloat()) {
+        scale = (args++)->AsFloat();
+      } else if (args->IsInt32()) {
+        height = (args++)->AsInt32();
+      }
+      if (args->IsInt32()) codec = (args++)->AsInt32();
+
+      if (!ImageCodec::isValid(codec)) {
+        INFO("/subscribe/module/overlay %ld unknown codec %d", moduleId, codec);
+        return;
+      }
+
+      ctrl->enqueueAction([=, this]() {
+        Recipe recipe = height > 0 ? Recipe(height) : Recipe(scale);
+        bool success = subman->subscribeModuleOverlay(
+          moduleId,
+          fps,
+          recipe,
+          (ImageCodec::Id)codec
+        );
+        osctx->enqueueBundler(
+          new OverlaySubscriptionAckBundler(moduleId, success)
+        );
+      });
+    }
+  );
+
+  routes.emplace(
+    "/set/texture_codec",
+    [&](osc::ReceivedMessage::const_iterator& args, const IpEndpointName&) {
+      int32_t codec = (args++)->AsInt32();
+
+      if (!ImageCodec::isValid(codec)) {
+        INFO("/set/texture_codec unknown codec %d", codec);
+        return;
+      }
+
+      INFO("texture codec set to %s", ImageCodec::name(codec));
+      textureCodec = codec;
+    }
+  );
+
   routes.emplace(
     "/set/param/value",
     [&](osc::ReceivedMessage::const_iterator& args, const IpEndpointName&) {
@@ -345,28 +724,144 @@ void OscReceiver::generateRoutes() {
       float value = (args++)->AsFloat();
       bool needsAck = (args++)->AsBool();
 
-      ctrl->enqueueAction([=, this]() {
-        ParamAckBundler* bundler = [&]() -> ParamAckBundler* {
-          ParamAckBundler* ack =
-            new ParamAckBundler(moduleId, paramId);
+      // a bypassed OSCctrl isn't processed, the ui thread takes over
+      OSCctrl* module = dynamic_cast<OSCctrl*>(ctrl->module);
+      if (directParamWrites && !module->isBypassed()) {
+        DirectParamWrite write{moduleId, paramId, value, needsAck};
+        if (module->directParamWrites.push(write)) return;
+      }
 
-          rack::app::ModuleWidget* module =
-            APP->scene->rack->getModule(moduleId);
-          if (!module) return ack->fail();
+      // the first write since the last apply schedules the next one
+      if (paramSlots.write(moduleId, paramId, value, needsAck))
+        ctrl->enqueueAction([this]() { applyParamWrites(); });
+    }
+  );
 
-          rack::app::ParamWidget* param = module->getParam(paramId);
-          if (!param) return ack->fail();
+  routes.emplace(
+    "/set/params",
+    [&](osc::ReceivedMessage::const_iterator& args, const IpEndpointName&) {
+      int64_t moduleId = (args++)->AsInt64();
 
-          rack::engine::ParamQuantity* pq = param->getParamQuantity();
-          pq->setValue(value);
-          return ack->success(pq->getValue());
-        }();
+      const void* blob;
+      osc::osc_bundle_element_size_t blobSize;
+      (args++)->AsBlob(blob, blobSize);
+
+      int32_t requestId{-1};
+      if (args->IsInt32()) requestId = (args++)->AsInt32();
+
+      // little-endian int32 paramId, float32 value pairs, a partial pair is dropped
+      const uint8_t* pairs = (const uint8_t*)blob;
+      std::vector<std::pair<ParamSlots::Key, float>> values(blobSize / 8);
+      for (size_t i = 0; i < values.size(); ++i) {
+        auto& [key, value] = values[i];
+        key.first = moduleId;
+        std::memcpy(&key.second, pairs + i * 8, 4);
+        std::memcpy(&value, pairs + i * 8 + 4, 4);
+      }
 
-        if (needsAck) {
-          osctx->enqueueBundler(bundler);
-        } else {
-          delete bundler;
-        }
+      // queued behind earlier /set/param/value writes, ahead of later ones
+      if (paramSlots.writeBatch(requestId, values))
+        ctrl->enqueueAction([this]() { applyParamWrites(); });
+    }
+  );
+
+  routes.emplace(
+    "/set/params/multi",
+    [&](osc::ReceivedMessage::const_iterator& args, const IpEndpointName&) {
+      const void* blob;
+      osc::osc_bundle_element_size_t blobSize;
+      (args++)->AsBlob(blob, blobSize);
+
+      int32_t requestId{-1};
+      if (args->IsInt32()) requestId = (args++)->AsInt32();
+
+      // same records /ack/params sends back: little-endian int64 moduleId,
+      // int32 paramId, float32 value
+      const uint8_t* records = (const uint8_t*)blob;
+      const size_t recordSize = ParamsAckBundler::RECORD_SIZE;
+      std::vector<std::pair<ParamSlots::Key, float>> values(blobSize / recordSize);
+      for (size_t i = 0; i < values.size(); ++i) {
+        const uint8_t* record = records + i * recordSize;
+        auto& [key, value] = values[i];
+        std::memcpy(&key.first, record, 8);
+        std::memcpy(&key.second, record + 8, 4);
+        std::memcpy(&value, record + 12, 4);
+      }
+
+      if (paramSlots.writeBatch(requestId, values))
+        ctrl->enqueueAction([this]() { applyParamWrites(); });
+    }
+  );
+
+  routes.emplace(
+    "/set/param/direct",
+    [&](osc::ReceivedMessage::const_iterator& args, const IpEndpointName&) {
+      bool direct = (args++)->AsBool();
+
+      INFO("direct param writes %s", direct ? "on" : "off");
+      directParamWrites = direct;
+    }
+  );
+
+  routes.emplace(
+    "/stream/cv",
+    [&](osc::ReceivedMessage::const_iterator& args, const IpEndpointName&) {
+      int32_t outputId = (args++)->AsInt32();
+      int32_t channels = (args++)->AsInt32();
+      float sampleRate = (args++)->AsFloat();
+
+      const void* blob;
+      osc::osc_bundle_element_size_t blobSize;
+      (args++)->AsBlob(blob, blobSize);
+
+      int32_t interpolation{CvStream::LINEAR};
+      if (args->IsInt32()) interpolation = (args++)->AsInt32();
+
+      if (outputId < 0 || outputId >= OSCctrl::NUM_CV_OUTPUTS) {
+        INFO("/stream/cv unknown output %d", outputId);
+        return;
+      }
+      if (channels < 1 || channels > rack::engine::PORT_MAX_CHANNELS) {
+        INFO("/stream/cv %d bad channel count %d", outputId, channels);
+        return;
+      }
+      if (sampleRate <= 0.f) {
+        INFO("/stream/cv %d bad sample rate %f", outputId, sampleRate);
+        return;
+      }
+
+      OSCctrl* module = dynamic_cast<OSCctrl*>(ctrl->module);
+      CvStream& stream = module->cvStreams[outputId];
+      stream.channels = channels;
+      stream.sampleRate = sampleRate;
+      stream.interpolation = interpolation;
+
+      // interleaved little-endian float32 frames, a partial frame is dropped
+      const uint8_t* samples = (const uint8_t*)blob;
+      size_t frameSize = channels * sizeof(float);
+      for (size_t offset = 0; offset + frameSize <= (size_t)blobSize; offset += frameSize) {
+        CvFrame frame;
+        std::memcpy(frame.voltages, samples + offset, frameSize);
+        if (!stream.push(frame)) break;
+      }
+    }
+  );
+
+  routes.emplace(
+    "/get/stream/cv/stats",
+    [&](osc::ReceivedMessage::const_iterator& args, const IpEndpointName&) {
+      int32_t outputId = (args++)->AsInt32();
+
+      if (outputId < 0 || outputId >= OSCctrl::NUM_CV_OUTPUTS) {
+        INFO("/get/stream/cv/stats unknown output %d", outputId);
+        return;
+      }
+
+      ctrl->enqueueAction([=, this]() {
+        OSCctrl* module = dynamic_cast<OSCctrl*>(ctrl->module);
+        osctx->enqueueBundler(
+          new CvStreamStatsBundler(outputId, module->cvStreams[outputId])
+        );
       });
     }
   );
@@ -387,47 +882,50 @@ void OscReceiver::generateRoutes() {
       } catch (const osc::WrongArgumentTypeException& e) {}
 
       ctrl->enqueueAction([=, this]() {
-        CableAckBundler* bundler = [&]() -> CableAckBundler* {
-          CableAckBundler* ack =
-            new CableAckBundler(CableAckType::Add, returnId);
-
-          // ack success if cable already exists
-          std::vector<int64_t> cableIds = APP->engine->getCableIds();
-          for (int64_t cableId : cableIds) {
-            rack::engine::Cable* cable = APP->engine->getCable(cableId);
-            if (cable->inputModule->getId() != inputModuleId) continue;
-            if (cable->outputModule->getId() != outputModuleId) continue;
-            if (cable->inputId != inputPortId) continue;
-            if (cable->outputId != outputPortId) continue;
-            return ack->success(cableId);
-          }
+        CableAckBundler* ack = new CableAckBundler(CableAckType::Add, returnId);
+        int64_t cableId = addCable(
+          {outputModuleId, outputPortId, inputModuleId, inputPortId},
+          rack::color::fromHexString(color)
+        );
+        osctx->enqueueBundler(cableId == -1 ? ack->fail() : ack->success(cableId));
+      });
+    }
+  );
 
-          // TODO: history (see PortWidget::dragStart/dragEnd for example)
-          rack::app::ModuleWidget* inputModule =
-            APP->scene->rack->getModule(inputModuleId);
-          if (!inputModule) return ack->fail();
-          rack::app::ModuleWidget* outputModule =
-            APP->scene->rack->getModule(outputModuleId);
-          if (!outputModule) return ack->fail();
-
-          rack::app::PortWidget* inputPort = inputModule->getInput(inputPortId);
-          if (!inputPort) return ack->fail();
-          rack::app::PortWidget* outputPort = outputModule->getOutput(outputPortId);
-          if (!outputPort) return ack->fail();
-
-          rack::app::CableWidget* cableWidget = new rack::app::CableWidget;
-          cableWidget->inputPort = inputPort;
-          cableWidget->outputPort = outputPort;
-          cableWidget->color = rack::color::fromHexString(color);
-
-          // updateCable handles creating and adding the engine::Cable
-          cableWidget->updateCable();
-          APP->scene->rack->addCable(cableWidget);
-
-          return ack->success(cableWidget->getCable()->id);
-        }();
+  routes.emplace(
+    "/add/cables",
+    [&](osc::ReceivedMessage::const_iterator& args, const IpEndpointName&) {
+      const void* blob;
+      osc::osc_bundle_element_size_t blobSize;
+      (args++)->AsBlob(blob, blobSize);
+
+      int64_t returnId{-1};
+      if (args->IsInt64()) returnId = (args++)->AsInt64();
+
+      // little-endian int64 inputModuleId, int64 outputModuleId,
+      // int32 inputPortId, int32 outputPortId, RGBA color bytes
+      const uint8_t* records = (const uint8_t*)blob;
+      const size_t recordSize{28};
+      std::vector<std::pair<CableIndex::Key, NVGcolor>> cables(blobSize / recordSize);
+      for (size_t i = 0; i < cables.size(); ++i) {
+        const uint8_t* record = records + i * recordSize;
+        CableIndex::Key& key = cables[i].first;
+        std::memcpy(&key.inputModuleId, record, 8);
+        std::memcpy(&key.outputModuleId, record + 8, 8);
+        std::memcpy(&key.inputPortId, record + 16, 4);
+        std::memcpy(&key.outputPortId, record + 20, 4);
+        cables[i].second = nvgRGBA(record[24], record[25], record[26], record[27]);
+      }
 
-        osctx->enqueueBundler(bundler);
+      ctrl->enqueueAction([this, returnId, cables = std::move(cables)]() {
+        std::vector<int64_t> cableIds;
+        cableIds.reserve(cables.size());
+        for (const auto& [key, color] : cables)
+          cableIds.push_back(addCable(key, color));
+
+        osctx->enqueueBundler(
+          new CableBatchAckBundler(CableAckType::Add, returnId, cableIds)
+        );
       });
     }
   );
@@ -449,6 +947,7 @@ void OscReceiver::generateRoutes() {
 
           APP->scene->rack->removeCable(cw);
           delete cw;
+          cableIndex.remove(cableId);
           return ack->success(cableId);
         }();
 
@@ -457,21 +956,65 @@ void OscReceiver::generateRoutes() {
     }
   );
 
+  routes.emplace(
+    "/remove/cables",
+    [&](osc::ReceivedMessage::const_iterator& args, const IpEndpointName&) {
+      const void* blob;
+      osc::osc_bundle_element_size_t blobSize;
+      (args++)->AsBlob(blob, blobSize);
+
+      int64_t returnId{-1};
+      if (args->IsInt64()) returnId = (args++)->AsInt64();
+
+      // little-endian int64 cable ids
+      std::vector<int64_t> cableIds(blobSize / sizeof(int64_t));
+      std::memcpy(cableIds.data(), blob, cableIds.size() * sizeof(int64_t));
+
+      ctrl->enqueueAction([this, returnId, cableIds = std::move(cableIds)]() mutable {
+        // RackWidget::getCable walks every cable, look them all up in one pass
+        std::unordered_map<int64_t, rack::app::CableWidget*> widgets;
+        for (rack::app::CableWidget* cw : APP->scene->rack->getCompleteCables())
+          widgets[cw->getCable()->id] = cw;
+
+        // TODO: history (see PortWidget::dragStart/dragEnd for example)
+        for (int64_t& cableId : cableIds) {
+          auto it = widgets.find(cableId);
+          if (it == widgets.end()) {
+            cableId = -1;
+            continue;
+          }
+
+          APP->scene->rack->removeCable(it->second);
+          delete it->second;
+          widgets.erase(it);
+          cableIndex.remove(cableId);
+        }
+
+        osctx->enqueueBundler(
+          new CableBatchAckBundler(CableAckType::Remove, returnId, cableIds)
+        );
+      });
+    }
+  );
+
   routes.emplace(
     "/patch/open",
     [&](osc::ReceivedMessage::const_iterator& args, const IpEndpointName&) {
       std::string path = (args++)->AsString();
       ctrl->enqueueAction([&, path]() {
         SceneAction::Create([&, path]() {
+          // the load can give new modules old ids at old addresses
+          OverlayContext::clear();
           APP->patch->load(path);
           APP->patch->path = path;
           APP->history->setSaved();
+          cableIndex.invalidate();
         });
       });
     }
   );
 
-  // TEMPLATE
+  // TEMPLATE, the path also goes in ROUTE_PATHS
   // routes.emplace(
   //   "",
   //   [&](osc::ReceivedMessage::const_iterator& args, const IpEndpointName& remoteEndpoint) {
@@ -480,3 +1023,162 @@ void OscReceiver::generateRoutes() {
   //   }
   // );
 }
+
+void OscReceiver::applyParamWrites() {
+  std::map<ParamSlots::Key, ParamSlots::Write> writes;
+  std::vector<ParamSlots::Batch> batches;
+  paramSlots.take(writes, batches);
+
+  ParamAckBundler* acks = new ParamAckBundler();
+
+  for (const auto& [key, write] : writes) {
+    const auto& [moduleId, paramId] = key;
+
+    rack::app::ModuleWidget* module = APP->scene->rack->getModule(moduleId);
+    rack::app::ParamWidget* param = module ? module->getParam(paramId) : NULL;
+    rack::engine::ParamQuantity* pq = param ? param->getParamQuantity() : NULL;
+
+    if (!pq) {
+      if (write.needsAck) acks->fail(moduleId, paramId);
+      continue;
+    }
+
+    pq->setValue(write.value);
+    if (write.needsAck) acks->success(moduleId, paramId, pq->getValue());
+  }
+
+  if (acks->isNoop()) {
+    delete acks;
+  } else {
+    osctx->enqueueBundler(acks);
+  }
+
+  for (const ParamSlots::Batch& batch : batches) ackParamBatch(batch);
+}
+
+int64_t OscReceiver::addCable(const CableIndex::Key& key, NVGcolor color) {
+  // an existing cable counts as added
+  int64_t existing = cableIndex.find(key);
+  if (existing != -1) return existing;
+
+  // TODO: history (see PortWidget::dragStart/dragEnd for example)
+  rack::app::ModuleWidget* inputModule =
+    APP->scene->rack->getModule(key.inputModuleId);
+  if (!inputModule) return -1;
+  rack::app::ModuleWidget* outputModule =
+    APP->scene->rack->getModule(key.outputModuleId);
+  if (!outputModule) return -1;
+
+  rack::app::PortWidget* inputPort = inputModule->getInput(key.inputPortId);
+  if (!inputPort) return -1;
+  rack::app::PortWidget* outputPort = outputModule->getOutput(key.outputPortId);
+  if (!outputPort) return -1;
+
+  rack::app::CableWidget* cableWidget = new rack::app::CableWidget;
+  cableWidget->inputPort = inputPort;
+  cableWidget->outputPort = outputPort;
+  cableWidget->color = color;
+
+  // updateCable handles creating and adding the engine::Cable
+  cableWidget->updateCable();
+  APP->scene->rack->addCable(cableWidget);
+
+  int64_t cableId = cableWidget->getCable()->id;
+  cableIndex.add(key, cableId);
+  return cableId;
+}
+
+void OscReceiver::ackParamBatch(const ParamSlots::Batch& batch) {
+  std::vector<ParamsAckBundler::Result> results(batch.params.size());
+
+  // batches are usually one module's params, look it up once per run
+  int64_t lastModuleId{-1};
+  rack::app::ModuleWidget* module{NULL};
+
+  for (size_t i = 0; i < batch.params.size(); ++i) {
+    const auto& [moduleId, paramId] = batch.params[i];
+    if (moduleId != lastModuleId) {
+      lastModuleId = moduleId;
+      module = APP->scene->rack->getModule(moduleId);
+    }
+
+    rack::app::ParamWidget* paramWidget = module ? module->getParam(paramId) : NULL;
+    rack::engine::ParamQuantity* pq =
+      paramWidget ? paramWidget->getParamQuantity() : NULL;
+
+    results[i].moduleId = moduleId;
+    results[i].paramId = paramId;
+    results[i].value = pq ? pq->getValue() : NAN;
+  }
+
+  osctx->enqueueBundler(new ParamsAckBundler(batch.requestId, results));
+}
+
+void OscReceiver::sendDirectParamAcks() {
+  OSCctrl* module = dynamic_cast<OSCctrl*>(ctrl->module);
+  if (module->directParamAcks.empty()) return;
+
+  ParamAckBundler* acks = new ParamAckBundler();
+
+  DirectParamAck ack;
+  while (module->directParamAcks.pop(ack)) {
+    if (ack.success) {
+      acks->success(ack.moduleId, ack.paramId, ack.value);
+    } else {
+      acks->fail(ack.moduleId, ack.paramId);
+    }
+  }
+
+  osctx->enqueueBundler(acks);
+}
+
+void OscReceiver::sendTexture(
+  int64_t textureId,
+  const RenderResult& render,
+  bool ensureEnqueue,
+  int32_t flags,
+  ImageCodec::Id codec,
+  const Recipe& recipe
+) {
+  if (render.failure()) {
+    INFO("failed to render texture %lld", textureId);
+    INFO("  %s", render.statusMessage.c_str());
+    return;
+  }
+
+  // unknown texture, or nothing to draw
+  if (render.empty()) return;
+
+  bool progressive = flags & TEXTURE_FLAG_PROGRESSIVE;
+
+  // the preview goes straight to the sender, ahead of any queued chunks
+  if (progressive)
+    osctx->enqueueBundler(new TexturePreviewBundler(textureId, render));
+
+  ChunkedImage* chunkedImage = new ChunkedImage(render);
+  chunkedImage->id = textureId;
+  chunkedImage->lowPriority = progressive;
+  chunkedImage->codec = codec;
+  chunkedImage->format = recipe.format;
+  if (TextureCache::isCacheable(textureId, recipe))
+    chunkedImage->cacheKey = TextureCache::makeKey(textureId, recipe, codec);
+  chunkman->add(chunkedImage, ensureEnqueue);
+}
+
+bool OscReceiver::sendCachedTexture(
+  int64_t textureId,
+  const Recipe& recipe,
+  ImageCodec::Id codec,
+  bool ensureEnqueue
+) {
+  if (!TextureCache::isCacheable(textureId, recipe)) return false;
+
+  EncodedTexture encoded;
+  if (!TextureCache::get(TextureCache::makeKey(textureId, recipe, codec), encoded))
+    return false;
+
+  ChunkedImage* chunkedImage = new ChunkedImage(encoded);
+  chunkedImage->id = textureId;
+  chunkman->add(chunkedImage, ensureEnqueue);
+  return true;
+}
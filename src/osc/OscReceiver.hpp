@@ -1,7 +1,7 @@
 #include <thread>
-#include <map>
 #include <functional>
 #include <mutex>
+#include <atomic>
 
 #include <chrono>
 #include "../util/Timer.hpp"
@@ -12,11 +12,19 @@
 #include "oscpack/osc/OscReceivedElements.h"
 
 #include "OscConstants.hpp"
+#include "RouteTable.hpp"
+#include "ParamSlots.hpp"
+#include "CableIndex.hpp"
+#include "Bundler/ParamsAckBundler.hpp"
+#include "BatchListener.hpp"
+#include "../texture/ImageCodec.hpp"
 
 class OSCctrlWidget;
 class OscSender;
 class ChunkedManager;
 class SubscriptionManager;
+struct RenderResult;
+struct Recipe;
 
 struct OscReceiver : public osc::OscPacketListener {
   OscReceiver(
@@ -29,14 +37,24 @@ struct OscReceiver : public osc::OscPacketListener {
 
   inline static int32_t activePort{RX_PORT};
 
+  // ack the params OSCctrl::process wrote since the last call, ui thread
+  void sendDirectParamAcks();
+
 private:
   OSCctrlWidget* ctrl;
   OscSender* osctx;
   ChunkedManager* chunkman;
   SubscriptionManager* subman;
 
+  // for image sends that don't name a codec, see /set/texture_codec
+  std::atomic<int32_t> textureCodec{ImageCodec::QOI};
+
   IpEndpointName endpoint;
+#ifdef ARCH_LIN
+  BatchListener* rxSocket = NULL;
+#else
   UdpListeningReceiveSocket* rxSocket = NULL;
+#endif
 	std::thread listenerThread;
   int8_t maxBindRetries{20};
 
@@ -46,18 +64,49 @@ private:
     const osc::ReceivedMessage& message,
     const IpEndpointName& remoteEndpoint
   ) override;
+  // honors timetags on /set/param/value, everything else is immediate
+  void ProcessBundle(
+    const osc::ReceivedBundle& bundle,
+    const IpEndpointName& remoteEndpoint
+  ) override;
+  // false if the write can't be scheduled and should be handled now
+  bool scheduleParamWrite(const osc::ReceivedMessage& message, uint64_t timeTag);
 
-  std::map<
-    std::string,
-    std::function<
-      void(
-        osc::ReceivedMessage::const_iterator&,
-        const IpEndpointName&
-      )
-    >
-  > routes;
+  RouteTable routes;
   void generateRoutes();
 
+  // /set/param/value writes and /set/params batches waiting for the UI
+  // thread, newest per param
+  ParamSlots paramSlots;
+  void applyParamWrites();
+  // /ack/params with the values a /set/params batch left its params at
+  void ackParamBatch(const ParamSlots::Batch& batch);
+  // write params from OSCctrl::process instead, see /set/param/direct
+  std::atomic<bool> directParamWrites{false};
+
+  // ui thread, see addCable
+  CableIndex cableIndex;
+  // id of the new cable, or the one already between these ports. -1 if
+  // either port doesn't exist.
+  int64_t addCable(const CableIndex::Key& key, NVGcolor color);
+
+  // hand a finished /get/texture render to the chunked manager
+  void sendTexture(
+    int64_t textureId,
+    const RenderResult& render,
+    bool ensureEnqueue,
+    int32_t flags,
+    ImageCodec::Id codec,
+    const Recipe& recipe
+  );
+  // false if there's nothing in TextureCache for the recipe
+  bool sendCachedTexture(
+    int64_t textureId,
+    const Recipe& recipe,
+    ImageCodec::Id codec,
+    bool ensureEnqueue
+  );
+
   void startHeartbeat();
   std::chrono::time_point<std::chrono::steady_clock> lastHeartbeatRxTime =
     std::chrono::steady_clock::time_point::min();
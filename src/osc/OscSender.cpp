@@ -67,7 +67,9 @@ void OscSender::sendHeartbeat() {
     enqueueBundler(new BroadcastHeartbeatBundler());
   } else {
     module->hbOutPulse.trigger();
-    enqueueBundler(new DirectHeartbeatBundler());
+    enqueueBundler(
+      new DirectHeartbeatBundler(module->paramScheduler.lateEvents)
+    );
   }
 }
 
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+#include "../util/SpscRing.hpp"
+
+// /set/param/value headed straight for the engine, see /set/param/direct
+struct DirectParamWrite {
+  int64_t moduleId{-1};
+  int32_t paramId{-1};
+  float value{0.f};
+  bool needsAck{false};
+};
+
+// the value a direct write left the param at, for /ack/param/value
+struct DirectParamAck {
+  int64_t moduleId{-1};
+  int32_t paramId{-1};
+  float value{0.f};
+  bool success{false};
+};
+
+// timetagged param writes, held on the audio thread until the sample they're
+// due. times are rack::system::getTime() seconds.
+struct ParamScheduler {
+  static const size_t CAPACITY{1024};
+
+  struct Event {
+    double time{0.0};
+    DirectParamWrite write;
+  };
+
+  // receiver thread. false if the audio thread is too far behind.
+  bool schedule(double time, const DirectParamWrite& write) {
+    return incoming.push({time, write});
+  }
+
+  // audio thread. cheap check before working out the current time.
+  bool idle() const { return numPending == 0 && incoming.empty(); }
+
+  // audio thread. apply every event due at or before now, in time order.
+  // events that arrived after they were due are applied right away.
+  template <typename Apply>
+  void process(double now, Apply apply) {
+    Event event;
+    while (incoming.pop(event)) {
+      if (event.time < now) ++lateEvents;
+
+      if (event.time <= now || numPending == CAPACITY) {
+        apply(event.write);
+        continue;
+      }
+
+      pending[numPending++] = event;
+      siftUp(numPending - 1);
+    }
+
+    while (numPending > 0 && pending[0].time <= now) {
+      apply(pending[0].write);
+      pending[0] = pending[--numPending];
+      siftDown(0);
+    }
+  }
+
+  // since the session started, read from any thread
+  std::atomic<uint32_t> lateEvents{0};
+
+private:
+  SpscRing<Event, CAPACITY> incoming;
+
+  // min-heap on time, audio thread only
+  std::array<Event, CAPACITY> pending;
+  size_t numPending{0};
+
+  void siftUp(size_t i) {
+    while (i > 0) {
+      size_t parent = (i - 1) / 2;
+      if (pending[parent].time <= pending[i].time) return;
+      std::swap(pending[parent], pending[i]);
+      i = parent;
+    }
+  }
+
+  void siftDown(size_t i) {
+    while (true) {
+      size_t left = i * 2 + 1;
+      size_t right = left + 1;
+      size_t earliest = i;
+
+      if (left < numPending && pending[left].time < pending[earliest].time)
+        earliest = left;
+      if (right < numPending && pending[right].time < pending[earliest].time)
+        earliest = right;
+      if (earliest == i) return;
+
+      std::swap(pending[earliest], pending[i]);
+      i = earliest;
+    }
+  }
+};
@@ -0,0 +1,43 @@
+#include "ParamSlots.hpp"
+
+bool ParamSlots::write(
+  int64_t moduleId,
+  int32_t paramId,
+  float value,
+  bool needsAck
+) {
+  std::lock_guard<std::mutex> locker(slotMutex);
+  bool wasEmpty = slots.empty() && pendingBatches.empty();
+
+  Write& slot = slots[{moduleId, paramId}];
+  slot.value = value;
+  slot.needsAck |= needsAck;
+
+  return wasEmpty;
+}
+
+bool ParamSlots::writeBatch(
+  int32_t requestId,
+  const std::vector<std::pair<Key, float>>& values
+) {
+  Batch batch;
+  batch.requestId = requestId;
+  batch.params.reserve(values.size());
+  for (const auto& [key, value] : values) batch.params.push_back(key);
+
+  std::lock_guard<std::mutex> locker(slotMutex);
+  bool wasEmpty = slots.empty() && pendingBatches.empty();
+
+  for (const auto& [key, value] : values) slots[key].value = value;
+  pendingBatches.push_back(std::move(batch));
+
+  return wasEmpty;
+}
+
+void ParamSlots::take(std::map<Key, Write>& writes, std::vector<Batch>& batches) {
+  writes.clear();
+  batches.clear();
+  std::lock_guard<std::mutex> locker(slotMutex);
+  slots.swap(writes);
+  pendingBatches.swap(batches);
+}
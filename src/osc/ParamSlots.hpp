@@ -0,0 +1,43 @@
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// newest value written to each param since the UI thread last looked, so a
+// fast gesture is applied (and acked) once per frame instead of per message
+struct ParamSlots {
+  typedef std::pair<int64_t /* moduleId */, int32_t /* paramId */> Key;
+
+  struct Write {
+    float value{0.f};
+    // any coalesced write asked for an ack
+    bool needsAck{false};
+  };
+
+  // a /set/params or /set/params/multi batch, acked as a whole once the
+  // table it was written into is applied
+  struct Batch {
+    int32_t requestId{-1};
+    std::vector<Key> params;
+  };
+
+  // receiver thread. true if the table was empty, i.e. nothing is scheduled
+  // to apply it yet.
+  bool write(int64_t moduleId, int32_t paramId, float value, bool needsAck);
+  // receiver thread. written into the same table as single writes, so both
+  // are applied in the order they arrived.
+  bool writeBatch(
+    int32_t requestId,
+    const std::vector<std::pair<Key, float>>& values
+  );
+
+  // ui thread. empties the table into writes and batches.
+  void take(std::map<Key, Write>& writes, std::vector<Batch>& batches);
+
+private:
+  std::map<Key, Write> slots;
+  std::vector<Batch> pendingBatches;
+  std::mutex slotMutex;
+};
@@ -0,0 +1,78 @@
+#include "PortTap.hpp"
+
+void PortTap::resolvePort() {
+  port = NULL;
+
+  // modules are only removed between blocks, with the engine locked
+  rack::engine::Module* module = APP->engine->getModule_NoLock(moduleId);
+  if (!module) return;
+
+  if (isOutput) {
+    if (portId >= 0 && portId < (int32_t)module->outputs.size())
+      port = &module->outputs[portId];
+  } else {
+    if (portId >= 0 && portId < (int32_t)module->inputs.size())
+      port = &module->inputs[portId];
+  }
+}
+
+void PortTap::stop() {
+  int32_t expected = Running;
+  if (state.compare_exchange_strong(expected, Stopping)) return;
+
+  // the audio thread hasn't picked it up yet
+  expected = Starting;
+  state.compare_exchange_strong(expected, Free);
+}
+
+void PortTap::process() {
+  int32_t current = state.load(std::memory_order_acquire);
+  if (current == Free) return;
+
+  if (current == Stopping) {
+    port = NULL;
+    resolvedBlock = -1;
+    state.store(Free, std::memory_order_release);
+    return;
+  }
+
+  if (current == Starting) {
+    // the ui thread can take back a tap that hasn't started
+    if (!state.compare_exchange_strong(current, Running)) return;
+    windowCount = 0;
+    resolvedBlock = -1;
+  }
+
+  // a cached port is good for the rest of the block
+  int64_t block = APP->engine->getBlock();
+  if (block != resolvedBlock) {
+    resolvePort();
+    resolvedBlock = block;
+  }
+  if (!port) return;
+
+  int32_t channels = port->getChannels();
+  const float* voltages = port->getVoltages();
+
+  if (windowCount == 0) {
+    window.channels = channels;
+    for (int32_t c = 0; c < channels; ++c)
+      window.min[c] = window.max[c] = voltages[c];
+  } else {
+    int32_t previous = window.channels;
+    window.channels = std::max(previous, channels);
+    for (int32_t c = 0; c < channels; ++c) {
+      if (envelope && c < previous) {
+        window.min[c] = std::min(window.min[c], voltages[c]);
+        window.max[c] = std::max(window.max[c], voltages[c]);
+      } else {
+        window.min[c] = window.max[c] = voltages[c];
+      }
+    }
+  }
+
+  if (++windowCount < decimation) return;
+  windowCount = 0;
+
+  if (!frames.push(window)) ++overruns;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "rack.hpp"
+
+#include <atomic>
+
+#include "../util/SpscRing.hpp"
+
+// one decimated sample of every channel on a port, or the min and max of
+// each channel over the decimation window
+struct PortFrame {
+  float min[rack::engine::PORT_MAX_CHANNELS]{};
+  float max[rack::engine::PORT_MAX_CHANNELS]{};
+  int32_t channels{0};
+};
+
+// a /subscribe/port subscription, sampled by OSCctrl::process into a ring the
+// ui thread drains. slots are fixed so the audio thread never allocates.
+struct PortTap {
+  // at most 50ms at 48kHz undecimated, more than a ui frame
+  static const size_t CAPACITY{2048};
+
+  // who owns the slot. only the ui thread moves it out of Free and Running,
+  // only the audio thread moves it out of Starting and Stopping.
+  enum State : int32_t {
+    Free,
+    Starting,
+    Running,
+    Stopping,
+  };
+  std::atomic<int32_t> state{Free};
+
+  // set by the ui thread while Free, fixed until the tap is Free again
+  int64_t moduleId{-1};
+  int32_t portId{-1};
+  bool isOutput{true};
+  // engine samples per frame
+  int32_t decimation{1};
+  // min/max of the window rather than its last sample
+  bool envelope{false};
+
+  // audio thread -> ui thread
+  SpscRing<PortFrame, CAPACITY> frames;
+  // frames the ui didn't drain in time, read from any thread
+  std::atomic<uint32_t> overruns{0};
+
+  // ui thread
+  void stop();
+
+  // audio thread
+  void process();
+
+private:
+  // audio thread only
+  rack::engine::Port* port{NULL};
+  int64_t resolvedBlock{-1};
+  int32_t windowCount{0};
+  PortFrame window;
+
+  void resolvePort();
+};
@@ -0,0 +1,211 @@
+#include "Prewarmer.hpp"
+
+#include "../OSCctrl.hpp"
+#include "../util/Util.hpp"
+#include "../util/WorkerPool.hpp"
+
+#include "../texture/ImageCodec.hpp"
+#include "../texture/SvgRasterizer.hpp"
+
+Prewarmer::Prewarmer(OSCctrlWidget* _ctrl): ctrl(_ctrl) {}
+
+void Prewarmer::start() {
+  for (int64_t moduleId : APP->engine->getModuleIds()) {
+    rack::engine::Module* module = APP->engine->getModule(moduleId);
+    if (!module) continue;
+
+    rack::plugin::Model* model = module->getModel();
+    ModelSlugs slugs{model->plugin->slug, model->slug};
+    if (queuedModels.contains(slugs)) continue;
+
+    queuedModels.insert(slugs);
+    models.push_back(slugs);
+  }
+}
+
+void Prewarmer::stop() {
+  models.clear();
+  queuedModels.clear();
+  ingests.clear();
+  textures.clear();
+}
+
+bool Prewarmer::running() {
+  return !models.empty() || !ingests.empty() || !textures.empty();
+}
+
+void Prewarmer::step() {
+  if (!running()) return;
+
+  double deadline = rack::system::getTime() + FRAME_BUDGET;
+
+  do {
+    if (!textures.empty()) {
+      auto [textureId, recipe] = textures.front();
+      textures.pop_front();
+      warmTexture(textureId, recipe);
+    } else if (!ingests.empty()) {
+      ComponentIngest component = ingests.front();
+      ingests.pop_front();
+      ingest(component);
+    } else {
+      ModelSlugs slugs = models.front();
+      models.pop_front();
+      planModel(slugs);
+    }
+  } while (running() && rack::system::getTime() < deadline);
+
+  if (!running()) queuedModels.clear();
+}
+
+void Prewarmer::planModel(const ModelSlugs& slugs) {
+  const auto& [pluginSlug, moduleSlug] = slugs;
+
+  // the panel id is ingested last, so the components are in already
+  if (Catalog::getPanelId(pluginSlug, moduleSlug) != -1) {
+    queueTextures(slugs);
+    return;
+  }
+
+  rack::plugin::Model* model = gtnosft::util::findModel(pluginSlug, moduleSlug);
+  if (!model) return;
+
+  // only listed here, each component is rendered in a later step
+  rack::app::ModuleWidget* moduleWidget =
+    gtnosft::util::makeConnectedModuleWidget(model);
+  if (!moduleWidget) return;
+
+  for (rack::app::ParamWidget* paramWidget : moduleWidget->getParams()) {
+    rack::engine::ParamQuantity* pq = paramWidget->getParamQuantity();
+    if (!pq) continue;
+
+    // same order as ModuleStructureBundler, sliders are knobs too
+    if (dynamic_cast<rack::app::SvgSlider*>(paramWidget)) {
+      ingests.push_back({slugs, TextureType::Slider_track, pq->paramId});
+      ingests.push_back({slugs, TextureType::Slider_handle, pq->paramId});
+    } else if (dynamic_cast<rack::app::Knob*>(paramWidget)) {
+      ingests.push_back({slugs, TextureType::Knob_bg, pq->paramId});
+      ingests.push_back({slugs, TextureType::Knob_mg, pq->paramId});
+      ingests.push_back({slugs, TextureType::Knob_fg, pq->paramId});
+    } else if (dynamic_cast<rack::app::Switch*>(paramWidget)) {
+      ingests.push_back({
+        slugs,
+        TextureType::Switch_frame,
+        pq->paramId,
+        (int32_t)pq->getMaxValue() + 1
+      });
+    }
+  }
+
+  for (rack::app::PortWidget* portWidget : moduleWidget->getPorts()) {
+    ingests.push_back({
+      slugs,
+      portWidget->type == rack::engine::Port::INPUT
+        ? TextureType::Port_input
+        : TextureType::Port_output,
+      portWidget->portId
+    });
+  }
+
+  delete moduleWidget;
+
+  ingests.push_back({slugs, TextureType::Panel});
+}
+
+void Prewarmer::ingest(const ComponentIngest& component) {
+  const auto& [pluginSlug, moduleSlug] = component.slugs;
+
+  switch (component.textureType) {
+    case TextureType::Panel:
+      Catalog::pullPanelId(pluginSlug, moduleSlug);
+      queueTextures(component.slugs);
+      break;
+    case TextureType::Switch_frame: {
+      int64_t stripId;
+      Catalog::pullSwitchIds(
+        pluginSlug,
+        moduleSlug,
+        component.componentId,
+        component.numFrames,
+        stripId
+      );
+      break;
+    }
+    default:
+      Catalog::pullComponentId(
+        pluginSlug,
+        moduleSlug,
+        component.componentId,
+        component.textureType
+      );
+      break;
+  }
+}
+
+void Prewarmer::queueTextures(const ModelSlugs& slugs) {
+  const auto& [pluginSlug, moduleSlug] = slugs;
+
+  std::vector<int64_t> textureIds =
+    Catalog::getComponentIds(pluginSlug, moduleSlug);
+  int64_t panelId = Catalog::getPanelId(pluginSlug, moduleSlug);
+  if (panelId != -1) textureIds.insert(textureIds.begin(), panelId);
+
+  for (int64_t textureId : textureIds) {
+    for (float scale : SCALES) {
+      Recipe recipe(scale);
+      TextureCacheKey key =
+        TextureCache::makeKey(textureId, recipe, ImageCodec::QOI);
+      if (TextureCache::contains(key)) continue;
+
+      textures.emplace_back(textureId, recipe);
+    }
+  }
+}
+
+void Prewarmer::warmTexture(int64_t textureId, const Recipe& recipe) {
+  TextureCacheKey key = TextureCache::makeKey(textureId, recipe, ImageCodec::QOI);
+
+  // plain svgs don't need the GL context, draw them on the pool too
+  RasterJob job;
+  if (Catalog::prepareRaster(textureId, recipe, job)) {
+    ctrl->rasterPool->enqueue([=, this]() {
+      RenderResult render = SvgRasterizer::render(job);
+      if (render.success()) encodeTexture(key, render);
+    });
+    return;
+  }
+
+  // only the readback needs the GL context
+  RenderResult render = Catalog::pullTexture(textureId, recipe);
+  if (!render.success()) return;
+
+  ctrl->rasterPool->enqueue([=, this]() { encodeTexture(key, render); });
+}
+
+void Prewarmer::encodeTexture(
+  const TextureCacheKey& key,
+  const RenderResult& render
+) {
+  // what ChunkedImage makes of a render at the default recipe
+  EncodedTexture encoded;
+  encoded.data = ImageCodec::encode(
+    ImageCodec::QOI,
+    render.pixels.data(),
+    render.width,
+    render.height,
+    PixelFormat::bytesPerPixel(PixelFormat::RGBA8888),
+    encoded.size
+  );
+  if (!encoded.data) return;
+
+  encoded.width = render.width;
+  encoded.height = render.height;
+  encoded.offsetX = render.offsetX;
+  encoded.offsetY = render.offsetY;
+  encoded.originalWidth = render.originalWidth;
+  encoded.originalHeight = render.originalHeight;
+  encoded.codec = ImageCodec::QOI;
+  encoded.format = PixelFormat::RGBA8888;
+
+  ctrl->enqueueAction([=]() { TextureCache::put(key, encoded); });
+}
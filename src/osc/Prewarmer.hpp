@@ -0,0 +1,65 @@
+#pragma once
+
+#include "rack.hpp"
+
+#include <deque>
+#include <set>
+#include <utility>
+
+#include "../texture/Catalog.hpp"
+#include "../texture/Renderer.hpp"
+#include "../texture/TextureCache.hpp"
+
+class OSCctrlWidget;
+
+// renders and encodes the patch's panels and component textures into
+// TextureCache ahead of any client asking, a little every UI frame. encodes
+// run on the raster pool, everything else on the ui thread.
+struct Prewarmer {
+  // what clients ask for most, at the default codec and pixel format
+  static constexpr float SCALES[]{1.f, 2.f};
+  // seconds of each frame spent warming. one unit of work always goes
+  // through: listing a model's components, one component's catalog ingest,
+  // or one texture's render.
+  static constexpr double FRAME_BUDGET{0.004};
+
+  Prewarmer(OSCctrlWidget* _ctrl);
+
+  // queue every model in the patch
+  void start();
+  void stop();
+  bool running();
+
+  void step();
+
+private:
+  OSCctrlWidget* ctrl{NULL};
+
+  typedef std::pair<std::string, std::string> ModelSlugs;
+
+  // the 8x8 render and hash of one component, what ModuleStructureBundler
+  // does for each param and port. a Panel ingest comes last for each model
+  // and queues its textures.
+  struct ComponentIngest {
+    ModelSlugs slugs;
+    TextureType textureType;
+    int32_t componentId{0};
+    // Switch_frame only
+    int32_t numFrames{0};
+  };
+
+  std::deque<ModelSlugs> models;
+  std::set<ModelSlugs> queuedModels;
+  std::deque<ComponentIngest> ingests;
+  std::deque<std::pair<int64_t, Recipe>> textures;
+
+  // queue an ingest per component, or the textures if the model's ids are
+  // already in Catalog
+  void planModel(const ModelSlugs& slugs);
+  void ingest(const ComponentIngest& component);
+  // queue a model's textures that aren't cached yet
+  void queueTextures(const ModelSlugs& slugs);
+  void warmTexture(int64_t textureId, const Recipe& recipe);
+  // on the raster pool. builds no ChunkedSend, their ids are the ui thread's.
+  void encodeTexture(const TextureCacheKey& key, const RenderResult& render);
+};
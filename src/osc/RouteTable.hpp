@@ -0,0 +1,151 @@
+#pragma once
+
+#include "rack.hpp"
+
+#include <array>
+#include <cstring>
+#include <functional>
+#include <string_view>
+
+#include "oscpack/ip/IpEndpointName.h"
+#include "oscpack/osc/OscReceivedElements.h"
+
+// every address OscReceiver answers, hashed into RouteTable at compile time.
+// a new route needs its path here as well as a handler in generateRoutes.
+inline constexpr std::array<std::string_view, 29> ROUTE_PATHS{
+  "/register",
+  "/keepalive",
+  "/ack_chunk",
+  "/get/action_stats",
+  "/get/patch_info",
+  "/get/module_stubs",
+  "/get/cables",
+  "/get/module_structure",
+  "/get/texture",
+  "/get/texture/region",
+  "/get/module_atlas",
+  "/get/panel_vector",
+  "/get/module_state",
+  "/get/params_state",
+  "/subscribe/module/lights",
+  "/subscribe/module/overlay",
+  "/subscribe/port",
+  "/set/texture_codec",
+  "/set/param/value",
+  "/set/param/direct",
+  "/set/params",
+  "/set/params/multi",
+  "/stream/cv",
+  "/get/stream/cv/stats",
+  "/add/cable",
+  "/remove/cable",
+  "/add/cables",
+  "/remove/cables",
+  "/patch/open",
+};
+
+// seeded FNV-1a, searched for a seed that gives every route its own slot
+namespace gtnosft {
+namespace route_hash {
+
+inline constexpr size_t NUM_SLOTS{128};
+static_assert((NUM_SLOTS & (NUM_SLOTS - 1)) == 0, "NUM_SLOTS must be a power of 2");
+static_assert(ROUTE_PATHS.size() < 127, "route indices must fit in an int8_t");
+
+// also counts the path's length, so a lookup reads it once
+constexpr size_t slot(const char* path, size_t& length, uint32_t seed) {
+  uint32_t h = 2166136261u ^ seed;
+  for (length = 0; path[length]; ++length) {
+    h ^= (uint8_t)path[length];
+    h *= 16777619u;
+  }
+  // fold the high bits into the slot bits
+  return (h ^ (h >> 15)) & (NUM_SLOTS - 1);
+}
+
+constexpr uint32_t findSeed() {
+  for (uint32_t seed = 0; seed < 100000; ++seed) {
+    std::array<bool, NUM_SLOTS> used{};
+    bool collided{false};
+
+    for (const std::string_view& path : ROUTE_PATHS) {
+      size_t length{0};
+      size_t i = slot(path.data(), length, seed);
+      if (used[i]) {
+        collided = true;
+        break;
+      }
+      used[i] = true;
+    }
+
+    if (!collided) return seed;
+  }
+  return UINT32_MAX;
+}
+
+inline constexpr uint32_t SEED{findSeed()};
+static_assert(SEED != UINT32_MAX, "no collision-free seed, raise NUM_SLOTS");
+
+// route index per slot, -1 if empty
+constexpr std::array<int8_t, NUM_SLOTS> makeSlots() {
+  std::array<int8_t, NUM_SLOTS> slots{};
+  slots.fill(-1);
+  for (size_t route = 0; route < ROUTE_PATHS.size(); ++route) {
+    size_t length{0};
+    slots[slot(ROUTE_PATHS[route].data(), length, SEED)] = route;
+  }
+  return slots;
+}
+
+inline constexpr std::array<int8_t, NUM_SLOTS> SLOTS{makeSlots()};
+
+// index into ROUTE_PATHS, -1 for an unknown path
+constexpr int32_t find(const char* path) {
+  size_t length{0};
+  int8_t route = SLOTS[slot(path, length, SEED)];
+  if (route == -1) return -1;
+
+  const std::string_view& candidate = ROUTE_PATHS[route];
+  if (candidate.size() != length) return -1;
+  if (std::char_traits<char>::compare(candidate.data(), path, length)) return -1;
+
+  return route;
+}
+
+} // namespace route_hash
+} // namespace gtnosft
+
+static_assert(gtnosft::route_hash::find("/set/param/value") != -1);
+static_assert(gtnosft::route_hash::find("/set/param/valu") == -1);
+
+// OSC address -> handler, resolved without building a string or walking a tree
+struct RouteTable {
+  typedef std::function<
+    void(
+      osc::ReceivedMessage::const_iterator&,
+      const IpEndpointName&
+    )
+  > Handler;
+
+  // false if the path isn't in ROUTE_PATHS
+  bool emplace(const char* path, Handler handler) {
+    int32_t route = gtnosft::route_hash::find(path);
+    if (route == -1) {
+      WARN("RouteTable: %s is not in ROUTE_PATHS, not routing it", path);
+      return false;
+    }
+
+    handlers[route] = handler;
+    return true;
+  }
+
+  // NULL if there's no handler for the path
+  const Handler* find(const char* path) const {
+    int32_t route = gtnosft::route_hash::find(path);
+    if (route == -1 || !handlers[route]) return NULL;
+    return &handlers[route];
+  }
+
+private:
+  std::array<Handler, ROUTE_PATHS.size()> handlers;
+};
@@ -6,6 +6,11 @@
 
 #include "Bundler/ModuleLightsBundler.hpp"
 #include "Bundler/ModuleParamsBundler.hpp"
+#include "Bundler/PortSamplesBundler.hpp"
+
+#include "ChunkedSend/ChunkedOverlayFrame.hpp"
+
+#include "../texture/TileDiff.hpp"
 
 SubscriptionManager::SubscriptionManager(
   OSCctrlWidget* _ctrl, OscSender* _osctx, ChunkedManager* _chunkman
@@ -19,9 +24,12 @@ void SubscriptionManager::start() {
 
 void SubscriptionManager::tick() {
   if (!running) return;
-  if (moduleLightSubs.empty()) return;
 
-  osctx->submitLights(new ModuleLightsBundler(moduleLightSubs));
+  if (!moduleLightSubs.empty())
+    osctx->submitLights(new ModuleLightsBundler(moduleLightSubs));
+
+  tickOverlays();
+  tickPorts();
 }
 
 void SubscriptionManager::reset() {
@@ -31,9 +39,15 @@ void SubscriptionManager::reset() {
   osctx->drainMailboxes();
 
   // clear cache after any other enqueued items
-  ctrl->enqueueAction([]() {
+  ctrl->enqueueAction([this]() {
     ModuleLightsBundler::lights.clear();
     // ModuleParamsBundler::params.clear();
+
+    moduleOverlaySubs.clear();
+
+    // only the ui thread moves taps out of Running
+    OSCctrl* module = dynamic_cast<OSCctrl*>(ctrl->module);
+    for (PortTap& tap : module->portTaps) tap.stop();
   });
 }
 
@@ -45,3 +59,238 @@ bool SubscriptionManager::subscribeModuleLights(int64_t moduleId) {
   return true;
 }
 // void unsubscribeModuleLights(int64_t moduleId);
+
+bool SubscriptionManager::subscribeModuleOverlay(
+  int64_t moduleId,
+  float fps,
+  const Recipe& recipe,
+  ImageCodec::Id codec
+) {
+  if (fps <= 0.f) {
+    unsubscribeModuleOverlay(moduleId);
+    return true;
+  }
+
+  rack::app::ModuleWidget* moduleWidget = APP->scene->rack->getModule(moduleId);
+  if (!moduleWidget) return false;
+  if (Renderer::isOverlayBlocklisted(moduleWidget)) return false;
+
+  // start over with a keyframe
+  unsubscribeModuleOverlay(moduleId);
+
+  OverlaySubscription& sub = moduleOverlaySubs[moduleId];
+  sub.recipe = recipe;
+  sub.codec = codec;
+  sub.interval = 1.0 / fps;
+
+  return true;
+}
+
+void SubscriptionManager::unsubscribeModuleOverlay(int64_t moduleId) {
+  moduleOverlaySubs.erase(moduleId);
+}
+
+bool SubscriptionManager::subscribePort(
+  int64_t moduleId,
+  int32_t portId,
+  bool isOutput,
+  int32_t decimation,
+  bool envelope
+) {
+  unsubscribePort(moduleId, portId, isOutput);
+  if (decimation <= 0) return true;
+
+  rack::engine::Module* target = APP->engine->getModule(moduleId);
+  if (!target) return false;
+
+  int32_t numPorts = isOutput ? target->outputs.size() : target->inputs.size();
+  if (portId < 0 || portId >= numPorts) return false;
+
+  OSCctrl* module = dynamic_cast<OSCctrl*>(ctrl->module);
+  for (PortTap& tap : module->portTaps) {
+    if (tap.state != PortTap::Free) continue;
+
+    // drop whatever the last subscription left behind
+    PortFrame frame;
+    while (tap.frames.pop(frame));
+
+    tap.moduleId = moduleId;
+    tap.portId = portId;
+    tap.isOutput = isOutput;
+    tap.decimation = decimation;
+    tap.envelope = envelope;
+    tap.overruns = 0;
+    tap.state = PortTap::Starting;
+    return true;
+  }
+
+  return false;
+}
+
+void SubscriptionManager::unsubscribePort(
+  int64_t moduleId,
+  int32_t portId,
+  bool isOutput
+) {
+  OSCctrl* module = dynamic_cast<OSCctrl*>(ctrl->module);
+  for (PortTap& tap : module->portTaps) {
+    if (tap.moduleId != moduleId) continue;
+    if (tap.portId != portId || tap.isOutput != isOutput) continue;
+
+    tap.stop();
+  }
+}
+
+void SubscriptionManager::tickPorts() {
+  OSCctrl* module = dynamic_cast<OSCctrl*>(ctrl->module);
+  float sampleRate = APP->engine->getSampleRate();
+
+  for (PortTap& tap : module->portTaps) {
+    if (tap.state != PortTap::Running) continue;
+
+    // module was removed from the patch
+    if (!APP->scene->rack->getModule(tap.moduleId)) {
+      tap.stop();
+      continue;
+    }
+
+    portFrames.clear();
+    PortFrame frame;
+    while (tap.frames.pop(frame)) portFrames.push_back(frame);
+    if (portFrames.empty()) continue;
+
+    int32_t decimation = tap.decimation;
+    bool envelope = tap.envelope;
+
+    // over budget, merge neighbouring frames into min/max envelopes
+    size_t merge = (portFrames.size() + MAX_PORT_FRAMES_PER_TICK - 1)
+      / MAX_PORT_FRAMES_PER_TICK;
+    if (merge > 1) {
+      size_t merged{0};
+      for (size_t i = 0; i < portFrames.size(); i += merge, ++merged) {
+        PortFrame envelopeFrame = portFrames[i];
+        size_t end = std::min(i + merge, portFrames.size());
+        for (size_t j = i + 1; j < end; ++j) {
+          const PortFrame& next = portFrames[j];
+          envelopeFrame.channels = std::max(envelopeFrame.channels, next.channels);
+          for (int32_t c = 0; c < next.channels; ++c) {
+            envelopeFrame.min[c] = std::min(envelopeFrame.min[c], next.min[c]);
+            envelopeFrame.max[c] = std::max(envelopeFrame.max[c], next.max[c]);
+          }
+        }
+        portFrames[merged] = envelopeFrame;
+      }
+      portFrames.resize(merged);
+      decimation *= merge;
+      envelope = true;
+    }
+
+    osctx->enqueueBundler(new PortSamplesBundler(
+      tap.moduleId,
+      tap.portId,
+      tap.isOutput,
+      portSequence++,
+      sampleRate,
+      decimation,
+      envelope,
+      portFrames
+    ));
+  }
+}
+
+void SubscriptionManager::tickOverlays() {
+  if (moduleOverlaySubs.empty()) return;
+
+  double now = rack::system::getTime();
+
+  for (auto it = moduleOverlaySubs.begin(); it != moduleOverlaySubs.end();) {
+    // module was removed from the patch
+    if (!APP->scene->rack->getModule(it->first)) {
+      it = moduleOverlaySubs.erase(it);
+      continue;
+    }
+
+    tickOverlay(it->first, it->second, now);
+    ++it;
+  }
+}
+
+void SubscriptionManager::tickOverlay(
+  int64_t moduleId,
+  OverlaySubscription& sub,
+  double now
+) {
+  if (now - sub.lastFrameTime < sub.interval) return;
+
+  // skip frames until the client has the last one
+  if (sub.inFlightId != -1 && chunkman->isProcessing(sub.inFlightId)) return;
+
+  sub.lastFrameTime = now;
+
+  RenderResult render = Renderer::renderOverlay(moduleId, sub.recipe);
+  if (!render.success()) return;
+
+  bool keyframe =
+    sub.needsKeyframe
+      || now - sub.lastKeyframeTime >= KEYFRAME_INTERVAL
+      || render.width != sub.width
+      || render.height != sub.height;
+
+  std::vector<uint32_t> tiles;
+  if (keyframe) {
+    TileDiff::allTiles(render.width, render.height, tiles);
+  } else {
+    TileDiff::findChangedTiles(
+      sub.lastFrame.data(),
+      render.pixels.data(),
+      render.width,
+      render.height,
+      tiles
+    );
+  }
+
+  // nothing moved
+  if (tiles.empty()) return;
+
+  PixelBuffer strip = TileDiff::packTiles(
+    render.pixels.data(),
+    render.width,
+    render.height,
+    tiles
+  );
+
+  // what the client has at the same tiles
+  PixelBuffer previousStrip;
+  if (sub.codec == ImageCodec::DELTA && !keyframe) {
+    previousStrip = TileDiff::packTiles(
+      sub.lastFrame.data(),
+      render.width,
+      render.height,
+      tiles
+    );
+  }
+
+  // nothing else writes to a finished render, hold on to it as is
+  sub.lastFrame = render.pixels;
+  sub.width = render.width;
+  sub.height = render.height;
+
+  if (keyframe) {
+    sub.lastKeyframeTime = now;
+    sub.needsKeyframe = false;
+  }
+
+  ChunkedOverlayFrame* frame = new ChunkedOverlayFrame(
+    moduleId,
+    sub.frameNum++,
+    render.width,
+    render.height,
+    keyframe,
+    tiles,
+    strip,
+    sub.codec,
+    previousStrip
+  );
+  sub.inFlightId = frame->id;
+  chunkman->add(frame);
+}
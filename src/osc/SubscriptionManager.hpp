@@ -1,11 +1,33 @@
 #include "rack.hpp"
 
 #include <algorithm>
+#include <map>
 #include <vector>
 
+#include "../texture/Renderer.hpp"
+#include "../texture/ImageCodec.hpp"
+#include "PortTap.hpp"
+
 class OSCctrlWidget;
 class OscSender;
 class ChunkedManager;
+struct OverlaySubscription {
+  Recipe recipe;
+  ImageCodec::Id codec{ImageCodec::QOI};
+  double interval{0.0}; // seconds between frames
+
+  double lastFrameTime{0.0};
+  double lastKeyframeTime{0.0};
+  bool needsKeyframe{true};
+  // chunked send id of the frame on its way to the client
+  int64_t inFlightId{-1};
+  int32_t frameNum{0};
+
+  // last frame sent, what the client has
+  PixelBuffer lastFrame;
+  int32_t width{0};
+  int32_t height{0};
+};
 
 struct SubscriptionManager {
   SubscriptionManager(
@@ -22,6 +44,26 @@ struct SubscriptionManager {
   bool subscribeModuleLights(int64_t moduleId);
   // void unsubscribeModuleLights(int64_t moduleId);
 
+  // fps <= 0 unsubscribes
+  bool subscribeModuleOverlay(
+    int64_t moduleId,
+    float fps,
+    const Recipe& recipe,
+    ImageCodec::Id codec
+  );
+  void unsubscribeModuleOverlay(int64_t moduleId);
+
+  // sampled into one of OSCctrl's fixed port taps, decimation <= 0
+  // unsubscribes. false if the port doesn't exist or every tap is taken.
+  bool subscribePort(
+    int64_t moduleId,
+    int32_t portId,
+    bool isOutput,
+    int32_t decimation,
+    bool envelope
+  );
+  void unsubscribePort(int64_t moduleId, int32_t portId, bool isOutput);
+
 private:
   OSCctrlWidget* ctrl{NULL};
   OscSender* osctx{NULL};
@@ -30,4 +72,16 @@ private:
   bool running{false};
 
   std::vector<int64_t> moduleLightSubs;
+
+  // full frames every so often in case a frame was lost
+  static constexpr double KEYFRAME_INTERVAL{5.0};
+  std::map<int64_t, OverlaySubscription> moduleOverlaySubs;
+  void tickOverlays();
+  void tickOverlay(int64_t moduleId, OverlaySubscription& sub, double now);
+
+  // frames sent per tap per tick, past this they're merged into envelopes
+  static const size_t MAX_PORT_FRAMES_PER_TICK{256};
+  std::vector<PortFrame> portFrames;
+  int32_t portSequence{0};
+  void tickPorts();
 };
@@ -0,0 +1,131 @@
+#include "Atlas.hpp"
+#include "Catalog.hpp"
+#include "../util/Util.hpp"
+
+#include "../osc/Bundler/ModuleStructureBundler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+void ShelfPacker::pack(
+  std::vector<AtlasEntry>& entries,
+  int32_t& atlasWidth,
+  int32_t& atlasHeight
+) {
+  atlasWidth = 0;
+  atlasHeight = 0;
+  if (entries.empty()) return;
+
+  // place tallest first to keep shelves tight, entries keep their order
+  std::vector<size_t> order(entries.size());
+  for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return entries[a].height > entries[b].height;
+  });
+
+  int64_t area{0};
+  int32_t widest{0};
+  for (const AtlasEntry& entry : entries) {
+    area += (int64_t)(entry.width + PADDING) * (entry.height + PADDING);
+    widest = std::max(widest, entry.width + PADDING);
+  }
+
+  // aim for a roughly square atlas
+  int32_t shelfWidth =
+    std::max(widest, (int32_t)std::ceil(std::sqrt((double)area)));
+
+  int32_t x{0}, y{0}, shelfHeight{0};
+  for (size_t i : order) {
+    AtlasEntry& entry = entries[i];
+
+    if (x + entry.width + PADDING > shelfWidth) {
+      y += shelfHeight;
+      x = 0;
+      shelfHeight = 0;
+    }
+
+    entry.x = x;
+    entry.y = y;
+
+    x += entry.width + PADDING;
+    shelfHeight = std::max(shelfHeight, entry.height + PADDING);
+    atlasWidth = std::max(atlasWidth, x);
+  }
+  atlasHeight = y + shelfHeight;
+}
+
+float Atlas::getComponentScale(
+  rack::app::ModuleWidget* moduleWidget,
+  const Recipe& recipe
+) {
+  if (recipe.type == RenderType::Scaled) return recipe.scale;
+
+  // an exact height is the height of the module's panel
+  float pixelRatio = std::fmax(1.f, std::floor(APP->window->pixelRatio));
+  return recipe.height / (moduleWidget->box.size.y * pixelRatio);
+}
+
+AtlasResult Atlas::build(
+  const std::string& pluginSlug,
+  const std::string& moduleSlug,
+  const Recipe& recipe
+) {
+  AtlasResult result;
+
+  rack::plugin::Model* model = gtnosft::util::findModel(pluginSlug, moduleSlug);
+  if (!model) {
+    result.render =
+      Renderer::MODEL_NOT_FOUND("Atlas::build", pluginSlug, moduleSlug);
+    return result;
+  }
+
+  rack::app::ModuleWidget* moduleWidget = gtnosft::util::makeModuleWidget(model);
+  if (!moduleWidget) {
+    result.render =
+      Renderer::MODULE_WIDGET_ERROR("Atlas::build", pluginSlug, moduleSlug);
+    return result;
+  }
+  Recipe componentRecipe(getComponentScale(moduleWidget, recipe));
+  delete moduleWidget;
+
+  // component ids are ingested while describing the module's structure
+  std::vector<int64_t> textureIds =
+    Catalog::getComponentIds(pluginSlug, moduleSlug);
+  if (textureIds.empty()) {
+    delete new ModuleStructureBundler(pluginSlug, moduleSlug);
+    textureIds = Catalog::getComponentIds(pluginSlug, moduleSlug);
+  }
+
+  std::vector<RenderResult> renders;
+  for (int64_t textureId : textureIds) {
+    RenderResult render = Catalog::pullTexture(textureId, componentRecipe);
+    if (!render.success()) continue;
+
+    result.entries.emplace_back(textureId, render.width, render.height);
+    renders.push_back(render);
+  }
+
+  if (renders.empty()) return result;
+
+  int32_t width, height;
+  ShelfPacker::pack(result.entries, width, height);
+
+  PixelBuffer pixels(width * height * 4);
+  std::memset(pixels.data(), 0, pixels.size());
+  for (size_t i = 0; i < renders.size(); ++i) {
+    const AtlasEntry& entry = result.entries[i];
+    const uint8_t* src = renders[i].pixels.data();
+
+    for (int32_t row = 0; row < entry.height; ++row) {
+      std::memcpy(
+        pixels.data() + ((entry.y + row) * width + entry.x) * 4,
+        src + row * entry.width * 4,
+        entry.width * 4
+      );
+    }
+  }
+
+  result.render = RenderResult(pixels, width, height);
+  return result;
+}
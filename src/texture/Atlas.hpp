@@ -0,0 +1,53 @@
+#pragma once
+
+#include "rack.hpp"
+
+#include <vector>
+
+#include "Renderer.hpp"
+
+// a component texture's placement within a module atlas, in pixels
+struct AtlasEntry {
+  int64_t textureId;
+  int32_t x{0};
+  int32_t y{0};
+  int32_t width;
+  int32_t height;
+
+  AtlasEntry(int64_t _textureId, int32_t _width, int32_t _height):
+    textureId(_textureId), width(_width), height(_height) {}
+};
+
+// packs rectangles into rows ("shelves") of decreasing height
+struct ShelfPacker {
+  // transparent gutter between entries so neighbors don't bleed when sampled
+  static const int32_t PADDING{1};
+
+  // assigns x/y to each entry, returns the atlas size
+  static void pack(
+    std::vector<AtlasEntry>& entries,
+    int32_t& atlasWidth,
+    int32_t& atlasHeight
+  );
+};
+
+struct AtlasResult {
+  RenderResult render;
+  std::vector<AtlasEntry> entries;
+};
+
+struct Atlas {
+  // render every component texture of a module into a single image
+  static AtlasResult build(
+    const std::string& pluginSlug,
+    const std::string& moduleSlug,
+    const Recipe& recipe
+  );
+
+private:
+  // the scale every component is rendered at, derived from the panel
+  static float getComponentScale(
+    rack::app::ModuleWidget* moduleWidget,
+    const Recipe& recipe
+  );
+};
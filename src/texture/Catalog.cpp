@@ -7,6 +7,8 @@
 
 #include "rapidhash/rapidhash.h"
 
+#include <algorithm>
+
 int64_t Catalog::ingest(Breadcrumbs breadcrumbs) {
   RenderResult render = Renderer::renderTexture(breadcrumbs, Recipe(8, 8));
 
@@ -15,8 +17,14 @@ int64_t Catalog::ingest(Breadcrumbs breadcrumbs) {
     return -1;
   }
 
-  uint64_t hash = hashBitmap(render.pixels);
+  int64_t textureId =
+    registerHash(breadcrumbs, hashBitmap(render.pixels.data()));
+  indexComponentId(breadcrumbs, textureId);
+
+  return textureId;
+}
 
+int64_t Catalog::registerHash(Breadcrumbs breadcrumbs, uint64_t hash) {
   // INFO("Catalog::ingest cache: %s", registry.contains(hash) ? "hit" : "miss");
 
   if (!registry.contains(hash)) {
@@ -26,13 +34,22 @@ int64_t Catalog::ingest(Breadcrumbs breadcrumbs) {
     textureBreadcrumbs.emplace(textureId, breadcrumbs);
   }
 
-  delete[] render.pixels;
-
   return registry.at(hash);
 }
 
-uint64_t Catalog::hashBitmap(uint8_t* pixels) {
-  return rapidhash(pixels, 256);
+void Catalog::indexComponentId(const Breadcrumbs& breadcrumbs, int64_t textureId) {
+  std::vector<int64_t>& componentIds =
+    componentTextureIds[breadcrumbs.pluginSlug][breadcrumbs.moduleSlug];
+  if (
+    std::find(componentIds.begin(), componentIds.end(), textureId)
+      == componentIds.end()
+  ) {
+    componentIds.push_back(textureId);
+  }
+}
+
+uint64_t Catalog::hashBitmap(uint8_t* pixels, size_t size) {
+  return rapidhash(pixels, size);
 }
 
 int64_t Catalog::makeId() {
@@ -47,10 +64,19 @@ RenderResult Catalog::pullTexture(uint64_t id, Recipe recipe) {
   return Renderer::renderTexture(textureBreadcrumbs.at(id), recipe);
 }
 
+bool Catalog::prepareRaster(uint64_t id, Recipe recipe, RasterJob& job) {
+  if (!textureBreadcrumbs.contains(id)) return false;
+  return Renderer::prepareRaster(textureBreadcrumbs.at(id), recipe, job);
+}
+
 int64_t Catalog::pullPanelId(rack::app::ModuleWidget* widget) {
-  std::string& pluginSlug = widget->getModel()->plugin->slug;
-  std::string& moduleSlug = widget->getModel()->slug;
+  return pullPanelId(widget->getModel()->plugin->slug, widget->getModel()->slug);
+}
 
+int64_t Catalog::pullPanelId(
+  const std::string& pluginSlug,
+  const std::string& moduleSlug
+) {
   if (!panelTextureIds.contains(pluginSlug))
     panelTextureIds.emplace(
       pluginSlug,
@@ -88,6 +114,51 @@ int64_t Catalog::pullOverlayId(rack::app::ModuleWidget* widget) {
   return overlayTextureIds.at(moduleId);
 }
 
+int64_t Catalog::pullAtlasId(
+  const std::string& pluginSlug,
+  const std::string& moduleSlug
+) {
+  auto& moduleAtlasIds = atlasTextureIds[pluginSlug];
+
+  if (!moduleAtlasIds.contains(moduleSlug)) {
+    int64_t atlasTextureId = makeId();
+
+    // reserve the id, atlases are never rendered through pullTexture
+    textureBreadcrumbs.emplace(
+      atlasTextureId,
+      Breadcrumbs(pluginSlug, moduleSlug, 0, TextureType::Atlas)
+    );
+    textureBreadcrumbs.at(atlasTextureId).setTextureId(atlasTextureId);
+
+    moduleAtlasIds.emplace(moduleSlug, atlasTextureId);
+  }
+
+  return moduleAtlasIds.at(moduleSlug);
+}
+
+int64_t Catalog::getPanelId(
+  const std::string& pluginSlug,
+  const std::string& moduleSlug
+) {
+  if (!panelTextureIds.contains(pluginSlug)) return -1;
+  if (!panelTextureIds.at(pluginSlug).contains(moduleSlug)) return -1;
+  return panelTextureIds.at(pluginSlug).at(moduleSlug);
+}
+
+std::vector<int64_t> Catalog::getComponentIds(
+  const std::string& pluginSlug,
+  const std::string& moduleSlug
+) {
+  if (!componentTextureIds.contains(pluginSlug)) return {};
+  if (!componentTextureIds.at(pluginSlug).contains(moduleSlug)) return {};
+  return componentTextureIds.at(pluginSlug).at(moduleSlug);
+}
+
+TextureType Catalog::getTextureType(int64_t textureId) {
+  if (!textureBreadcrumbs.contains(textureId)) return TextureType::Unknown;
+  return textureBreadcrumbs.at(textureId).textureType;
+}
+
 std::vector<int64_t> Catalog::pullIds(ParamType type, rack::app::ParamWidget* widget) {
   std::vector<int64_t> textureIds;
 
@@ -100,13 +171,11 @@ std::vector<int64_t> Catalog::pullIds(ParamType type, rack::app::ParamWidget* wi
           TextureType::Knob_fg,
         };
         for (TextureType& type : types) {
-          textureIds.push_back(Catalog::ingest(
-            Breadcrumbs(
-              widget->module->model->plugin->slug,
-              widget->module->model->slug,
-              widget->paramId,
-              type
-            )
+          textureIds.push_back(pullComponentId(
+            widget->module->model->plugin->slug,
+            widget->module->model->slug,
+            widget->paramId,
+            type
           ));
         }
       }
@@ -118,13 +187,11 @@ std::vector<int64_t> Catalog::pullIds(ParamType type, rack::app::ParamWidget* wi
           TextureType::Slider_handle
         };
         for (TextureType& type : types) {
-          textureIds.push_back(Catalog::ingest(
-            Breadcrumbs(
-              widget->module->model->plugin->slug,
-              widget->module->model->slug,
-              widget->paramId,
-              type
-            )
+          textureIds.push_back(pullComponentId(
+            widget->module->model->plugin->slug,
+            widget->module->model->slug,
+            widget->paramId,
+            type
           ));
         }
       }
@@ -132,18 +199,8 @@ std::vector<int64_t> Catalog::pullIds(ParamType type, rack::app::ParamWidget* wi
     case ParamType::Button:
     case ParamType::Switch:
       {
-        rack::engine::ParamQuantity* pq = widget->getParamQuantity();
-        for (int frameIdx = 0; frameIdx <= pq->getMaxValue(); ++frameIdx) {
-          textureIds.push_back(Catalog::ingest(
-            Breadcrumbs(
-              widget->module->model->plugin->slug,
-              widget->module->model->slug,
-              widget->paramId,
-              TextureType::Switch_frame,
-              frameIdx
-            )
-          ));
-        }
+        int64_t stripId;
+        textureIds = pullSwitchIds(widget, stripId);
       }
       break;
     case ParamType::Unknown:
@@ -153,17 +210,84 @@ std::vector<int64_t> Catalog::pullIds(ParamType type, rack::app::ParamWidget* wi
   return textureIds;
 }
 
+std::vector<int64_t> Catalog::pullSwitchIds(
+  rack::app::ParamWidget* widget,
+  int64_t& stripId
+) {
+  return pullSwitchIds(
+    widget->module->model->plugin->slug,
+    widget->module->model->slug,
+    widget->paramId,
+    widget->getParamQuantity()->getMaxValue() + 1,
+    stripId
+  );
+}
+
+std::vector<int64_t> Catalog::pullSwitchIds(
+  const std::string& pluginSlug,
+  const std::string& moduleSlug,
+  int32_t paramId,
+  int32_t numFrames,
+  int64_t& stripId
+) {
+  std::vector<int64_t> frameIds;
+  stripId = -1;
+
+  // render every frame in one pass, then hash each frame on its own
+  Breadcrumbs stripBreadcrumbs(
+    pluginSlug,
+    moduleSlug,
+    paramId,
+    TextureType::Switch_strip
+  );
+  RenderResult render = Renderer::renderTexture(stripBreadcrumbs, Recipe(8, 8));
+
+  if (render.empty() || render.failure()) return frameIds;
+
+  size_t frameSize = render.width * (render.height / numFrames) * 4;
+
+  for (int frameIdx = 0; frameIdx < numFrames; ++frameIdx) {
+    Breadcrumbs frameBreadcrumbs(
+      pluginSlug,
+      moduleSlug,
+      paramId,
+      TextureType::Switch_frame,
+      frameIdx
+    );
+    int64_t frameId = registerHash(
+      frameBreadcrumbs,
+      hashBitmap(render.pixels.data() + frameIdx * frameSize, frameSize)
+    );
+    indexComponentId(frameBreadcrumbs, frameId);
+    frameIds.push_back(frameId);
+  }
+
+  stripId = registerHash(
+    stripBreadcrumbs,
+    hashBitmap(render.pixels.data(), frameSize * numFrames)
+  );
+
+  return frameIds;
+}
+
 int64_t Catalog::pullId(PortType portType, rack::app::PortWidget* widget) {
   TextureType textureType;
   if (portType == PortType::Input) textureType = TextureType::Port_input;
   if (portType == PortType::Output) textureType = TextureType::Port_output;
 
-  return Catalog::ingest(
-    Breadcrumbs(
-      widget->module->model->plugin->slug,
-      widget->module->model->slug,
-      widget->portId,
-      textureType
-    )
+  return pullComponentId(
+    widget->module->model->plugin->slug,
+    widget->module->model->slug,
+    widget->portId,
+    textureType
   );
 }
+
+int64_t Catalog::pullComponentId(
+  const std::string& pluginSlug,
+  const std::string& moduleSlug,
+  int32_t componentId,
+  TextureType textureType
+) {
+  return ingest(Breadcrumbs(pluginSlug, moduleSlug, componentId, textureType));
+}
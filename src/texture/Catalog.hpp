@@ -12,8 +12,10 @@ enum class TextureType {
   Slider_track,
   Slider_handle,
   Switch_frame,
+  Switch_strip,
   Port_input,
   Port_output,
+  Atlas,
 };
 
 // ModuleStructureBundler
@@ -24,6 +26,9 @@ enum class PortType;
 struct RenderResult;
 struct Recipe;
 
+// SvgRasterizer
+struct RasterJob;
+
 struct Breadcrumbs {
   std::string pluginSlug{""};
   std::string moduleSlug{""};
@@ -71,14 +76,56 @@ struct IdentiHash {
 
 struct Catalog {
   static RenderResult pullTexture(uint64_t id, Recipe recipe);
+  // false if the texture can't be drawn without GL
+  static bool prepareRaster(uint64_t id, Recipe recipe, RasterJob& job);
 
   static int64_t pullPanelId(rack::app::ModuleWidget* widget);
+  static int64_t pullPanelId(
+    const std::string& pluginSlug,
+    const std::string& moduleSlug
+  );
   static int64_t pullOverlayId(rack::app::ModuleWidget* widget);
   static std::vector<int64_t> pullIds(
     ParamType type,
     rack::app::ParamWidget* widget
   );
   static int64_t pullId(PortType type, rack::app::PortWidget* widget);
+  // button/switch frame ids, plus the id of every frame stacked in one strip
+  static std::vector<int64_t> pullSwitchIds(
+    rack::app::ParamWidget* widget,
+    int64_t& stripId
+  );
+  // the same ingests by slug, without a widget. one component layer or one
+  // switch's frames at a time.
+  static int64_t pullComponentId(
+    const std::string& pluginSlug,
+    const std::string& moduleSlug,
+    int32_t componentId,
+    TextureType textureType
+  );
+  static std::vector<int64_t> pullSwitchIds(
+    const std::string& pluginSlug,
+    const std::string& moduleSlug,
+    int32_t paramId,
+    int32_t numFrames,
+    int64_t& stripId
+  );
+
+  static int64_t pullAtlasId(
+    const std::string& pluginSlug,
+    const std::string& moduleSlug
+  );
+  // panel texture id ingested for a module, -1 if none yet
+  static int64_t getPanelId(
+    const std::string& pluginSlug,
+    const std::string& moduleSlug
+  );
+  // component texture ids ingested for a module, empty if none yet
+  static std::vector<int64_t> getComponentIds(
+    const std::string& pluginSlug,
+    const std::string& moduleSlug
+  );
+  static TextureType getTextureType(int64_t textureId);
 
 private:
   static inline std::unordered_map<uint64_t, int64_t, IdentiHash> registry;
@@ -92,8 +139,21 @@ private:
     int64_t, // moduleId
     int64_t // textureId
   > overlayTextureIds;
+  static inline std::unordered_map<
+    std::string, // pluginSlug
+    std::unordered_map<std::string /* moduleSlug */, int64_t /* textureId */>
+  > atlasTextureIds;
+  static inline std::unordered_map<
+    std::string, // pluginSlug
+    std::unordered_map<
+      std::string, // moduleSlug
+      std::vector<int64_t> // textureIds
+    >
+  > componentTextureIds;
 
   static int64_t makeId();
   static int64_t ingest(Breadcrumbs breadcrumbs);
-  static uint64_t hashBitmap(uint8_t* pixels);
+  static int64_t registerHash(Breadcrumbs breadcrumbs, uint64_t hash);
+  static void indexComponentId(const Breadcrumbs& breadcrumbs, int64_t textureId);
+  static uint64_t hashBitmap(uint8_t* pixels, size_t size = 256);
 };
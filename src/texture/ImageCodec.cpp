@@ -0,0 +1,98 @@
+#include "ImageCodec.hpp"
+#include "../util/Lz4.hpp"
+
+#include "qoi/qoi.h"
+
+#include <cstring>
+#include <vector>
+
+bool ImageCodec::isValid(int32_t id) {
+  return id >= QOI && id <= DELTA;
+}
+
+const char* ImageCodec::name(int32_t id) {
+  switch (id) {
+    case QOI: return "qoi";
+    case RAW: return "raw";
+    case LZ4: return "lz4";
+    case DELTA: return "delta";
+    default: return "unknown";
+  }
+}
+
+PixelBuffer ImageCodec::encode(
+  Id codec,
+  const uint8_t* pixels,
+  int32_t width,
+  int32_t height,
+  int32_t depth,
+  int64_t& length,
+  const uint8_t* previous
+) {
+  int64_t size = (int64_t)width * height * depth;
+
+  switch (codec) {
+    case QOI:
+      if (depth != 4) return PixelBuffer();
+      return encodeQoi(pixels, width, height, length);
+    case RAW: {
+      PixelBuffer copy(size);
+      memcpy(copy.data(), pixels, size);
+      length = size;
+      return copy;
+    }
+    case LZ4:
+      return encodeLz4(pixels, size, length);
+    case DELTA: {
+      if (!previous) return PixelBuffer();
+
+      // unchanged pixels become runs of zeros
+      PixelBuffer delta(size);
+      uint8_t* dst = delta.data();
+      for (int64_t i = 0; i < size; ++i) dst[i] = pixels[i] ^ previous[i];
+
+      return encodeLz4(dst, size, length);
+    }
+    default:
+      return PixelBuffer();
+  }
+}
+
+PixelBuffer ImageCodec::encodeQoi(
+  const uint8_t* pixels,
+  int32_t width,
+  int32_t height,
+  int64_t& length
+) {
+  qoi_desc desc;
+  desc.width = width;
+  desc.height = height;
+  desc.channels = 4;
+  desc.colorspace = 0;
+
+  int compressedLength{0};
+  void* compressedData = qoi_encode(pixels, &desc, &compressedLength);
+  if (!compressedData) return PixelBuffer();
+
+  // qoi allocates its own worst case buffer, keep only what it wrote
+  PixelBuffer encoded(compressedLength);
+  memcpy(encoded.data(), compressedData, compressedLength);
+  free(compressedData);
+
+  length = compressedLength;
+  return encoded;
+}
+
+PixelBuffer ImageCodec::encodeLz4(
+  const uint8_t* data,
+  int64_t size,
+  int64_t& length
+) {
+  PixelBuffer scratch(Lz4::bound(size));
+  length = Lz4::compress(data, size, scratch.data());
+
+  // held for the whole chunked send, don't keep the worst case around
+  PixelBuffer encoded(length);
+  memcpy(encoded.data(), scratch.data(), length);
+  return encoded;
+}
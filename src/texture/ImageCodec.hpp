@@ -0,0 +1,43 @@
+#pragma once
+
+#include "rack.hpp"
+
+#include "../util/BufferPool.hpp"
+
+// how RGBA image data is encoded for the client, sent as an int32 in the
+// metadata of /set/texture and /set/overlay/frame. see API.md.
+struct ImageCodec {
+  enum Id : int32_t {
+    QOI = 0,
+    // uncompressed, cheapest over loopback
+    RAW = 1,
+    // LZ4 block, good with mostly transparent layers
+    LZ4 = 2,
+    // XOR with the previous frame, then LZ4. overlay frames only.
+    DELTA = 3,
+  };
+
+  static bool isValid(int32_t id);
+  static const char* name(int32_t id);
+
+  // encodes width * height pixels of depth bytes, empty on failure.
+  // QOI only takes 4 byte RGBA, DELTA needs the previous pixels.
+  static PixelBuffer encode(
+    Id codec,
+    const uint8_t* pixels,
+    int32_t width,
+    int32_t height,
+    int32_t depth,
+    int64_t& length,
+    const uint8_t* previous = NULL
+  );
+
+private:
+  static PixelBuffer encodeQoi(
+    const uint8_t* pixels,
+    int32_t width,
+    int32_t height,
+    int64_t& length
+  );
+  static PixelBuffer encodeLz4(const uint8_t* data, int64_t size, int64_t& length);
+};
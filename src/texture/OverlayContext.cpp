@@ -0,0 +1,83 @@
+#include "OverlayContext.hpp"
+
+OverlayContext::OverlayContext(rack::app::ModuleWidget* moduleWidget):
+  module(moduleWidget->getModule()),
+  source(moduleWidget) {
+  surrogate = moduleWidget->getModel()->createModuleWidget(module);
+
+  surrogate->children.front()->setVisible(false); // panel
+  Renderer::hideChildren(
+    surrogate,
+    moduleWidget->model->plugin->slug,
+    moduleWidget->model->slug
+  );
+
+  // TODO: for Fundamental:Scope, copy input cables to get proper colors
+  framebuffer = Renderer::wrapForRendering(surrogate);
+}
+
+OverlayContext::~OverlayContext() {
+  surrogate->module = NULL;
+  delete framebuffer;
+}
+
+bool OverlayContext::isCurrent(int64_t moduleId) {
+  rack::app::ModuleWidget* moduleWidget = APP->scene->rack->getModule(moduleId);
+  // an undo can bring the id back with the module at the same address, the
+  // widget would have to be reused too
+  return moduleWidget
+    && moduleWidget == source
+    && moduleWidget->getModule() == module;
+}
+
+RenderResult OverlayContext::render(const Recipe& recipe) {
+  lastUsedTime = rack::system::getTime();
+  framebuffer->step();
+
+  rack::math::Vec scale = Renderer::getScaleFromRecipe(framebuffer, recipe);
+  return Renderer(framebuffer).render(scale, recipe.trim);
+}
+
+OverlayContext* OverlayContext::get(rack::app::ModuleWidget* moduleWidget) {
+  int64_t moduleId = moduleWidget->getModule()->getId();
+
+  auto found = contexts.find(moduleId);
+  if (found != contexts.end()) {
+    if (found->second->isCurrent(moduleId)) return found->second;
+
+    delete found->second;
+    contexts.erase(found);
+  }
+
+  OverlayContext* context = new OverlayContext(moduleWidget);
+  contexts.emplace(moduleId, context);
+  return context;
+}
+
+void OverlayContext::prune() {
+  // removed modules are dropped every frame, so a surrogate never outlives
+  // its module's ParamQuantities by more than the frame it was removed in
+  double now = rack::system::getTime();
+  bool checkIdle = now - lastPruneTime >= PRUNE_INTERVAL;
+  if (checkIdle) lastPruneTime = now;
+
+  for (auto it = contexts.begin(); it != contexts.end();) {
+    OverlayContext* context = it->second;
+
+    if (
+      !context->isCurrent(it->first)
+        || (checkIdle && now - context->lastUsedTime > IDLE_TIMEOUT)
+    ) {
+      delete context;
+      it = contexts.erase(it);
+      continue;
+    }
+
+    ++it;
+  }
+}
+
+void OverlayContext::clear() {
+  for (auto& [moduleId, context] : contexts) delete context;
+  contexts.clear();
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "rack.hpp"
+
+#include <unordered_map>
+
+#include "Renderer.hpp"
+
+// a surrogate of a module's widget with only the live parts (displays,
+// params, lights) visible, wrapped in a framebuffer for repeated rendering
+struct OverlayContext {
+  OverlayContext(rack::app::ModuleWidget* moduleWidget);
+  ~OverlayContext();
+
+  // the module and widget the surrogate was made from, never dereferenced
+  // here
+  rack::engine::Module* module{NULL};
+  rack::app::ModuleWidget* source{NULL};
+
+  rack::app::ModuleWidget* surrogate{NULL};
+  rack::widget::FramebufferWidget* framebuffer{NULL};
+
+  double lastUsedTime{0.0};
+
+  // false once the module is gone or replaced, render must not be called
+  bool isCurrent(int64_t moduleId);
+
+  RenderResult render(const Recipe& recipe);
+
+  // contexts persist between renders, all of these are UI thread only.
+  // the cached context for a module, replaced if the module changed.
+  static OverlayContext* get(rack::app::ModuleWidget* moduleWidget);
+  // drop contexts for removed modules and ones that haven't rendered lately.
+  // every frame, before anything renders.
+  static void prune();
+  static void clear();
+
+private:
+  // seconds without a render before a context is dropped
+  static constexpr double IDLE_TIMEOUT{30.0};
+  // seconds between idle checks
+  static constexpr double PRUNE_INTERVAL{1.0};
+
+  static inline std::unordered_map<int64_t, OverlayContext*> contexts;
+  static inline double lastPruneTime{0.0};
+};
@@ -0,0 +1,168 @@
+#include "PanelVector.hpp"
+#include "../util/Util.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+PanelVectorResult PanelVector::build(
+  const std::string& pluginSlug,
+  const std::string& moduleSlug
+) {
+  PanelVectorResult result;
+
+  rack::plugin::Model* model = gtnosft::util::findModel(pluginSlug, moduleSlug);
+  if (!model) {
+    result.statusMessage = rack::string::f(
+      "PanelVector::build Model not found %s:%s",
+      pluginSlug.c_str(),
+      moduleSlug.c_str()
+    );
+    return result;
+  }
+
+  rack::app::ModuleWidget* moduleWidget = gtnosft::util::makeModuleWidget(model);
+  if (!moduleWidget) {
+    result.statusMessage = rack::string::f(
+      "PanelVector::build can't create ModuleWidget for %s:%s",
+      pluginSlug.c_str(),
+      moduleSlug.c_str()
+    );
+    return result;
+  }
+  DEFER({ delete moduleWidget; });
+
+  // ThemedSvgPanel is an SvgPanel, custom drawn panels have no vector source
+  rack::app::SvgPanel* panel =
+    dynamic_cast<rack::app::SvgPanel*>(moduleWidget->getPanel());
+  if (!panel || !panel->svg || !panel->svg->handle) {
+    result.statusMessage = rack::string::f(
+      "PanelVector::build %s:%s panel is not an svg",
+      pluginSlug.c_str(),
+      moduleSlug.c_str()
+    );
+    return result;
+  }
+
+  result.width = panel->svg->handle->width;
+  result.height = panel->svg->handle->height;
+  serialize(panel->svg->handle, result.data);
+
+  return result;
+}
+
+void PanelVector::serialize(const NSVGimage* image, std::vector<uint8_t>& out) {
+  out.insert(out.end(), MAGIC, MAGIC + 4);
+  write16(VERSION, out);
+  write16(0, out); // reserved
+  writeFloat(image->width, out);
+  writeFloat(image->height, out);
+
+  // filled in once we know how many shapes are drawable
+  size_t numShapesOffset = out.size();
+  write32(0, out);
+
+  uint32_t numShapes{0};
+  for (NSVGshape* shape = image->shapes; shape; shape = shape->next) {
+    if (!(shape->flags & NSVG_FLAGS_VISIBLE)) continue;
+    if (shape->fill.type == NSVG_PAINT_NONE && shape->stroke.type == NSVG_PAINT_NONE)
+      continue;
+
+    writeShape(shape, out);
+    ++numShapes;
+  }
+
+  for (int i = 0; i < 4; ++i)
+    out[numShapesOffset + i] = (numShapes >> (i * 8)) & 0xFF;
+}
+
+void PanelVector::writeShape(const NSVGshape* shape, std::vector<uint8_t>& out) {
+  uint8_t dashCount = std::max(0, std::min(8, (int)shape->strokeDashCount));
+
+  write8(shape->fillRule, out);
+  write8(shape->strokeLineJoin, out);
+  write8(shape->strokeLineCap, out);
+  write8(dashCount, out);
+  writeFloat(shape->opacity, out);
+  writeFloat(shape->strokeWidth, out);
+  writeFloat(shape->miterLimit, out);
+  writeFloat(shape->strokeDashOffset, out);
+  for (uint8_t i = 0; i < dashCount; ++i)
+    writeFloat(shape->strokeDashArray[i], out);
+
+  writePaint(shape->fill, out);
+  writePaint(shape->stroke, out);
+
+  size_t numPathsOffset = out.size();
+  write32(0, out);
+
+  uint32_t numPaths{0};
+  for (NSVGpath* path = shape->paths; path; path = path->next) {
+    // first point, then 3 per cubic bezier segment
+    if (path->npts < 4) continue;
+
+    write8(path->closed, out);
+    write32(path->npts, out);
+    for (int i = 0; i < path->npts * 2; ++i) writeFloat(path->pts[i], out);
+    ++numPaths;
+  }
+
+  for (int i = 0; i < 4; ++i)
+    out[numPathsOffset + i] = (numPaths >> (i * 8)) & 0xFF;
+}
+
+void PanelVector::writePaint(const NSVGpaint& paint, std::vector<uint8_t>& out) {
+  switch (paint.type) {
+    case NSVG_PAINT_COLOR:
+      write8(PaintType::Color, out);
+      // nanosvg's 0xAABBGGRR, i.e. RGBA byte order
+      write32(paint.color, out);
+      return;
+    case NSVG_PAINT_LINEAR_GRADIENT:
+    case NSVG_PAINT_RADIAL_GRADIENT: {
+      write8(
+        paint.type == NSVG_PAINT_LINEAR_GRADIENT
+          ? PaintType::LinearGradient
+          : PaintType::RadialGradient,
+        out
+      );
+
+      const NSVGgradient* gradient = paint.gradient;
+      // maps user space to the unit gradient space
+      for (int i = 0; i < 6; ++i) writeFloat(gradient->xform[i], out);
+      write8(gradient->spread, out);
+      writeFloat(gradient->fx, out);
+      writeFloat(gradient->fy, out);
+      write16(gradient->nstops, out);
+      for (int i = 0; i < gradient->nstops; ++i) {
+        write32(gradient->stops[i].color, out);
+        writeFloat(gradient->stops[i].offset, out);
+      }
+      return;
+    }
+    default:
+      write8(PaintType::None, out);
+      return;
+  }
+}
+
+void PanelVector::write8(uint8_t value, std::vector<uint8_t>& out) {
+  out.push_back(value);
+}
+
+void PanelVector::write16(uint16_t value, std::vector<uint8_t>& out) {
+  out.push_back(value & 0xFF);
+  out.push_back((value >> 8) & 0xFF);
+}
+
+void PanelVector::write32(uint32_t value, std::vector<uint8_t>& out) {
+  out.push_back(value & 0xFF);
+  out.push_back((value >> 8) & 0xFF);
+  out.push_back((value >> 16) & 0xFF);
+  out.push_back((value >> 24) & 0xFF);
+}
+
+void PanelVector::writeFloat(float value, std::vector<uint8_t>& out) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  write32(bits, out);
+}
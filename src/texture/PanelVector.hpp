@@ -0,0 +1,45 @@
+#pragma once
+
+#include "rack.hpp"
+
+#include <vector>
+
+// a module panel's nanosvg shapes serialized for clients to rasterize locally.
+// all values little-endian, see API.md for the layout.
+struct PanelVectorResult {
+  std::vector<uint8_t> data;
+  float width{0.f};
+  float height{0.f};
+  std::string statusMessage;
+
+  bool success() const { return !data.empty(); }
+  bool failure() const { return data.empty(); }
+};
+
+struct PanelVector {
+  static constexpr char MAGIC[4]{'G', 'T', 'P', 'V'};
+  static const uint16_t VERSION{1};
+
+  enum PaintType : uint8_t {
+    None = 0,
+    Color = 1,
+    LinearGradient = 2,
+    RadialGradient = 3,
+  };
+
+  static PanelVectorResult build(
+    const std::string& pluginSlug,
+    const std::string& moduleSlug
+  );
+
+  static void serialize(const NSVGimage* image, std::vector<uint8_t>& out);
+
+private:
+  static void writeShape(const NSVGshape* shape, std::vector<uint8_t>& out);
+  static void writePaint(const NSVGpaint& paint, std::vector<uint8_t>& out);
+
+  static void write8(uint8_t value, std::vector<uint8_t>& out);
+  static void write16(uint16_t value, std::vector<uint8_t>& out);
+  static void write32(uint32_t value, std::vector<uint8_t>& out);
+  static void writeFloat(float value, std::vector<uint8_t>& out);
+};
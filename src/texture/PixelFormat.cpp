@@ -0,0 +1,152 @@
+#include "PixelFormat.hpp"
+
+#include <cstdlib>
+
+bool PixelFormat::isValid(int32_t id) {
+  return id >= RGBA8888 && id <= RGBA4444;
+}
+
+const char* PixelFormat::name(int32_t id) {
+  switch (id) {
+    case RGBA8888: return "rgba8888";
+    case RGB565: return "rgb565";
+    case A8: return "a8";
+    case RGBA4444: return "rgba4444";
+    default: return "unknown";
+  }
+}
+
+int32_t PixelFormat::bytesPerPixel(Id format) {
+  switch (format) {
+    case RGB565:
+    case RGBA4444:
+      return 2;
+    case A8:
+      return 1;
+    default:
+      return 4;
+  }
+}
+
+PixelBuffer PixelFormat::convert(
+  Id format,
+  const uint8_t* pixels,
+  int32_t width,
+  int32_t height,
+  uint32_t& tint
+) {
+  int64_t numPixels = (int64_t)width * height;
+  tint = 0;
+
+  switch (format) {
+    case RGB565: {
+      if (!isOpaque(pixels, numPixels)) return PixelBuffer();
+
+      PixelBuffer out(numPixels * 2);
+      toRgb565(pixels, numPixels, out.data());
+      return out;
+    }
+    case A8: {
+      if (!findTint(pixels, numPixels, tint)) return PixelBuffer();
+
+      PixelBuffer out(numPixels);
+      toA8(pixels, numPixels, out.data());
+      return out;
+    }
+    case RGBA4444: {
+      PixelBuffer out(numPixels * 2);
+      toRgba4444(pixels, numPixels, out.data());
+      return out;
+    }
+    default:
+      return PixelBuffer();
+  }
+}
+
+bool PixelFormat::isOpaque(const uint8_t* pixels, int64_t numPixels) {
+  // no early exit, keeps the loop branchless for the vectorizer
+  uint8_t alpha{0xFF};
+  for (int64_t i = 0; i < numPixels; ++i) alpha &= pixels[i * 4 + 3];
+  return alpha == 0xFF;
+}
+
+bool PixelFormat::findTint(
+  const uint8_t* pixels,
+  int64_t numPixels,
+  uint32_t& tint
+) {
+  // the most opaque pixel has the most precise color
+  int64_t brightest{-1};
+  uint8_t maxAlpha{0};
+  for (int64_t i = 0; i < numPixels; ++i) {
+    if (pixels[i * 4 + 3] > maxAlpha) {
+      maxAlpha = pixels[i * 4 + 3];
+      brightest = i;
+    }
+  }
+
+  // fully transparent, any tint will do
+  if (brightest == -1) return true;
+
+  int32_t color[3];
+  for (int c = 0; c < 3; ++c) {
+    color[c] = std::min(
+      255,
+      (pixels[brightest * 4 + c] * 255 + maxAlpha / 2) / maxAlpha
+    );
+  }
+
+  for (int64_t i = 0; i < numPixels; ++i) {
+    const uint8_t* pixel = pixels + i * 4;
+    int32_t alpha = pixel[3];
+
+    for (int c = 0; c < 3; ++c) {
+      int32_t expected = (color[c] * alpha + 127) / 255;
+      if (std::abs(pixel[c] - expected) > TINT_TOLERANCE) return false;
+    }
+  }
+
+  tint = color[0] | (color[1] << 8) | (color[2] << 16) | (0xFF << 24);
+  return true;
+}
+
+// plain loops over fixed strides, left for the compiler to vectorize
+
+void PixelFormat::toRgb565(
+  const uint8_t* pixels,
+  int64_t numPixels,
+  uint8_t* out
+) {
+  for (int64_t i = 0; i < numPixels; ++i) {
+    const uint8_t* pixel = pixels + i * 4;
+    uint16_t r = (pixel[0] * 31 + 127) / 255;
+    uint16_t g = (pixel[1] * 63 + 127) / 255;
+    uint16_t b = (pixel[2] * 31 + 127) / 255;
+    uint16_t value = (r << 11) | (g << 5) | b;
+
+    out[i * 2] = value & 0xFF;
+    out[i * 2 + 1] = value >> 8;
+  }
+}
+
+void PixelFormat::toA8(const uint8_t* pixels, int64_t numPixels, uint8_t* out) {
+  for (int64_t i = 0; i < numPixels; ++i) out[i] = pixels[i * 4 + 3];
+}
+
+void PixelFormat::toRgba4444(
+  const uint8_t* pixels,
+  int64_t numPixels,
+  uint8_t* out
+) {
+  for (int64_t i = 0; i < numPixels; ++i) {
+    const uint8_t* pixel = pixels + i * 4;
+    uint16_t r = (pixel[0] * 15 + 127) / 255;
+    uint16_t g = (pixel[1] * 15 + 127) / 255;
+    uint16_t b = (pixel[2] * 15 + 127) / 255;
+    uint16_t a = (pixel[3] * 15 + 127) / 255;
+    uint16_t value = (r << 12) | (g << 8) | (b << 4) | a;
+
+    out[i * 2] = value & 0xFF;
+    out[i * 2 + 1] = value >> 8;
+  }
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "rack.hpp"
+
+#include "../util/BufferPool.hpp"
+
+// layout of texture pixels sent to the client, applied to premultiplied RGBA
+// after readback. sent as an int32 in the /set/texture metadata, see API.md.
+struct PixelFormat {
+  enum Id : int32_t {
+    // premultiplied, 4 bytes per pixel
+    RGBA8888 = 0,
+    // opaque, little-endian uint16 with red in the high bits
+    RGB565 = 1,
+    // coverage only, drawn with a single tint color
+    A8 = 2,
+    // premultiplied, little-endian uint16 with red in the high bits
+    RGBA4444 = 3,
+  };
+
+  // per channel difference allowed between a pixel and the tinted coverage
+  // it's replaced by in A8
+  static const int32_t TINT_TOLERANCE{2};
+
+  static bool isValid(int32_t id);
+  static const char* name(int32_t id);
+  static int32_t bytesPerPixel(Id format);
+
+  // converts width * height premultiplied RGBA pixels, empty if the image
+  // can't be shown in the format: RGB565 needs every pixel
+  // opaque, A8 needs every pixel to be one color. tint is set for A8, RGBA
+  // byte order.
+  static PixelBuffer convert(
+    Id format,
+    const uint8_t* pixels,
+    int32_t width,
+    int32_t height,
+    uint32_t& tint
+  );
+
+private:
+  static bool isOpaque(const uint8_t* pixels, int64_t numPixels);
+  static bool findTint(const uint8_t* pixels, int64_t numPixels, uint32_t& tint);
+
+  static void toRgb565(const uint8_t* pixels, int64_t numPixels, uint8_t* out);
+  static void toA8(const uint8_t* pixels, int64_t numPixels, uint8_t* out);
+  static void toRgba4444(const uint8_t* pixels, int64_t numPixels, uint8_t* out);
+};
@@ -0,0 +1,78 @@
+#include "PixelOps.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+void PixelOps::flipRows(uint8_t* pixels, int width, int height) {
+  size_t rowSize = (size_t)width * DEPTH;
+
+  // swap_ranges compiles to wide loads/stores, no row sized temporary needed
+  for (int y = 0; y < height / 2; ++y) {
+    uint8_t* row = pixels + y * rowSize;
+    uint8_t* flipRow = pixels + (height - y - 1) * rowSize;
+    std::swap_ranges(row, row + rowSize, flipRow);
+  }
+}
+
+void PixelOps::copyRegion(
+  const uint8_t* src,
+  int srcWidth,
+  int left,
+  int top,
+  int width,
+  int height,
+  uint8_t* dst,
+  bool flip
+) {
+  size_t srcRowSize = (size_t)srcWidth * DEPTH;
+  size_t rowSize = (size_t)width * DEPTH;
+  const uint8_t* srcStart = src + top * srcRowSize + left * DEPTH;
+
+  for (int y = 0; y < height; ++y) {
+    int dstY = flip ? height - y - 1 : y;
+    std::memcpy(dst + dstY * rowSize, srcStart + y * srcRowSize, rowSize);
+  }
+}
+
+bool PixelOps::findAlphaBounds(
+  const uint8_t* pixels,
+  int width,
+  int height,
+  int& left,
+  int& top,
+  int& right,
+  int& bottom
+) {
+  // RGBA bytes read as little-endian words put alpha in the high byte
+  const uint32_t ALPHA_MASK = 0xFF000000;
+  const uint32_t* words = reinterpret_cast<const uint32_t*>(pixels);
+
+  auto rowHasAlpha = [&](int y) {
+    const uint32_t* row = words + y * width;
+    uint32_t acc = 0;
+    for (int x = 0; x < width; ++x) acc |= row[x];
+    return (acc & ALPHA_MASK) != 0;
+  };
+
+  top = 0;
+  while (top < height && !rowHasAlpha(top)) ++top;
+  if (top == height) return false;
+
+  bottom = height - 1;
+  while (bottom > top && !rowHasAlpha(bottom)) --bottom;
+
+  // OR every remaining row together, then look for the outermost columns
+  std::vector<uint32_t> columns(words + top * width, words + (top + 1) * width);
+  for (int y = top + 1; y <= bottom; ++y) {
+    const uint32_t* row = words + y * width;
+    for (int x = 0; x < width; ++x) columns[x] |= row[x];
+  }
+
+  left = 0;
+  while (!(columns[left] & ALPHA_MASK)) ++left;
+  right = width - 1;
+  while (!(columns[right] & ALPHA_MASK)) --right;
+
+  return true;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "rack.hpp"
+
+// row level operations on premultiplied RGBA buffers
+struct PixelOps {
+  static const int DEPTH{4};
+
+  // reverse row order in place, GL reads back bottom row first
+  static void flipRows(uint8_t* pixels, int width, int height);
+
+  // copy a width x height region at left, top out of src into a packed dst,
+  // optionally reversing the row order on the way. top is counted in src's
+  // own row order.
+  static void copyRegion(
+    const uint8_t* src,
+    int srcWidth,
+    int left,
+    int top,
+    int width,
+    int height,
+    uint8_t* dst,
+    bool flip = false
+  );
+
+  // bounding box of pixels with any alpha, inclusive, in the buffer's own row
+  // order. false if every pixel is fully transparent.
+  static bool findAlphaBounds(
+    const uint8_t* pixels,
+    int width,
+    int height,
+    int& left,
+    int& top,
+    int& right,
+    int& bottom
+  );
+};
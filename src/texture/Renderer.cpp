@@ -1,8 +1,13 @@
 #include "Renderer.hpp"
+#include "PixelOps.hpp"
 #include "Catalog.hpp"
+#include "SvgRasterizer.hpp"
+#include "OverlayContext.hpp"
 #include "../util/Util.hpp"
 #include "math.hpp"
 
+#include <algorithm>
+
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include "stb_image_write.h"
 
@@ -32,6 +37,21 @@ RenderResult Renderer::OVERLAY_BLOCKLISTED(
   );
 }
 
+RenderResult Renderer::REGION_UNSUPPORTED(
+  std::string caller,
+  const Breadcrumbs& breadcrumbs
+) {
+  return RenderResult(
+    rack::string::f(
+      "Renderer::%s %s:%s region renders are panel only, texture type %d",
+      caller.c_str(),
+      breadcrumbs.pluginSlug.c_str(),
+      breadcrumbs.moduleSlug.c_str(),
+      breadcrumbs.textureType
+    )
+  );
+}
+
 RenderResult Renderer::UNKNOWN_TEXTURE_TYPE(
   std::string caller,
   const Breadcrumbs& breadcrumbs
@@ -98,6 +118,9 @@ RenderResult Renderer::renderTexture(
   const Breadcrumbs& breadcrumbs,
   const Recipe& recipe
 ) {
+  if (recipe.hasRegion() && breadcrumbs.textureType != TextureType::Panel)
+    return REGION_UNSUPPORTED("renderTexture", breadcrumbs);
+
   // Overlays need special handling
   if (breadcrumbs.textureType == TextureType::Overlay)
     return renderOverlay(breadcrumbs.moduleId, recipe);
@@ -111,9 +134,12 @@ RenderResult Renderer::renderTexture(
       breadcrumbs.moduleSlug
     );
 
-  // Switch_frame needs access to ParamQuantities
-  rack::app::ModuleWidget* moduleWidget =
+  // Switch_frame/Switch_strip need access to ParamQuantities
+  bool needsConnection =
     breadcrumbs.textureType == TextureType::Switch_frame
+      || breadcrumbs.textureType == TextureType::Switch_strip;
+  rack::app::ModuleWidget* moduleWidget =
+    needsConnection
       ? gtnosft::util::makeConnectedModuleWidget(model)
       : gtnosft::util::makeModuleWidget(model);
   if (!moduleWidget)
@@ -166,6 +192,13 @@ RenderResult Renderer::renderTexture(
         recipe
       );
       break;
+    case TextureType::Switch_strip:
+      result = renderSwitchStrip(
+        moduleWidget->getParam(breadcrumbs.componentId),
+        breadcrumbs,
+        recipe
+      );
+      break;
     case TextureType::Port_input:
     case TextureType::Port_output:
       result = renderPort(
@@ -189,6 +222,7 @@ RenderResult Renderer::renderTexture(
   //     rack::string::f("%lld", breadcrumbs.textureId)
   //   );
   // }
+
   return result;
 }
 
@@ -200,12 +234,22 @@ RenderResult Renderer::renderPanel(
   auto it = std::next(moduleWidget->children.begin());
   for (; it != moduleWidget->children.end(); ++it) (*it)->setVisible(false);
 
-  rack::widget::FramebufferWidget* wrapper = wrapForRendering(moduleWidget);
+  rack::widget::FramebufferWidget* wrapper;
+  if (recipe.hasRegion()) {
+    rack::math::Rect region(
+      gtnosft::util::vec2px(recipe.region.pos),
+      gtnosft::util::vec2px(recipe.region.size)
+    );
+    wrapper = wrapRegionForRendering(moduleWidget, region);
+    if (!wrapper) return RenderResult();
+  } else {
+    wrapper = wrapForRendering(moduleWidget);
+  }
 
   wrapper->step();
 
   rack::math::Vec scale = getScaleFromRecipe(wrapper, recipe);
-  RenderResult result = Renderer(wrapper).render(scale);
+  RenderResult result = Renderer(wrapper).render(scale, recipe.trim);
 
   removeFromWrapper(wrapper, moduleWidget);
   delete wrapper;
@@ -220,39 +264,14 @@ RenderResult Renderer::renderOverlay(
   rack::app::ModuleWidget* moduleWidget = APP->scene->rack->getModule(moduleId);
   if (!moduleWidget) return MODULE_NOT_FOUND("renderOverlay", moduleId);
 
-  if (moduleWidget->model->slug == "OSCctrl")
+  if (isOverlayBlocklisted(moduleWidget))
     return OVERLAY_BLOCKLISTED("renderOverlay", moduleId);
 
-  rack::app::ModuleWidget* surrogate =
-    moduleWidget->getModel()->createModuleWidget(moduleWidget->getModule());
-
-  surrogate->children.front()->setVisible(false); // panel
-  hideChildren(
-    surrogate,
-    moduleWidget->model->plugin->slug,
-    moduleWidget->model->slug
-  );
-
-  // TODO: for Fundamental:Scope, copy input cables to get proper colors
-  rack::widget::FramebufferWidget* framebuffer = wrapForRendering(surrogate);
-  framebuffer->step();
-  DEFER({
-    surrogate->module = NULL;
-    delete framebuffer;
-  });
+  return OverlayContext::get(moduleWidget)->render(recipe);
+}
 
-  rack::math::Vec scale = getScaleFromRecipe(framebuffer, recipe);
-  RenderResult result = Renderer(framebuffer).render(scale);
-  // if (result.success()) {
-  //   renderPng(
-  //     result.pixels,
-  //     result.width,
-  //     result.height,
-  //     "render_panel_test",
-  //     "overlay" + std::to_string(std::chrono::system_clock::now().time_since_epoch().count())
-  //   );
-  // }
-  return result;
+bool Renderer::isOverlayBlocklisted(rack::app::ModuleWidget* moduleWidget) {
+  return moduleWidget->model->slug == "OSCctrl";
 }
 
 RenderResult Renderer::renderSwitch(
@@ -276,7 +295,112 @@ RenderResult Renderer::renderSwitch(
   pq->setValue(breadcrumbs.frameIdx);
   switchWidget->step();
 
-  return Renderer(framebuffer).render(scale);
+  return Renderer(framebuffer).render(scale, recipe.trim);
+}
+
+RenderResult Renderer::renderSwitchStrip(
+  rack::app::ParamWidget* switchWidget,
+  const Breadcrumbs& breadcrumbs,
+  const Recipe& recipe
+) {
+  rack::widget::FramebufferWidget* framebuffer = findFramebuffer(switchWidget);
+  if (!framebuffer)
+    return WIDGET_NOT_FOUND(
+      "renderSwitchStrip-fb",
+      breadcrumbs.pluginSlug,
+      breadcrumbs.moduleSlug,
+      breadcrumbs.componentId
+    );
+  hideChildren(framebuffer);
+
+  rack::math::Vec scale = getScaleFromRecipe(framebuffer, recipe);
+
+  rack::engine::ParamQuantity* pq = switchWidget->getParamQuantity();
+  int numFrames = pq->getMaxValue() + 1;
+  if (numFrames < 1) return RenderResult();
+
+  // step the same widget through each frame
+  std::vector<RenderResult> frames;
+  for (int frameIdx = 0; frameIdx < numFrames; ++frameIdx) {
+    pq->setValue(frameIdx);
+    switchWidget->step();
+
+    frames.push_back(Renderer(framebuffer).render(scale));
+    if (frames.back().success()) continue;
+
+    return frames.back();
+  }
+
+  int width = frames.front().width;
+  int frameHeight = frames.front().height;
+
+  for (const RenderResult& frame : frames) {
+    if (frame.width == width && frame.height == frameHeight) continue;
+
+    return RenderResult(
+      rack::string::f(
+        "Renderer::renderSwitchStrip frame size mismatch %s:%s:%d",
+        breadcrumbs.pluginSlug.c_str(),
+        breadcrumbs.moduleSlug.c_str(),
+        breadcrumbs.componentId
+      )
+    );
+  }
+
+  // every frame is cut to the union of their bounds, so they stay evenly
+  // spaced and line up with each other
+  int left{0}, top{0}, right{width - 1}, bottom{frameHeight - 1};
+  if (recipe.trim) {
+    bool anyFound = false;
+    for (const RenderResult& frame : frames) {
+      int frameLeft, frameTop, frameRight, frameBottom;
+      if (!PixelOps::findAlphaBounds(
+        frame.pixels.data(),
+        width,
+        frameHeight,
+        frameLeft,
+        frameTop,
+        frameRight,
+        frameBottom
+      )) continue;
+
+      if (!anyFound) {
+        left = frameLeft;
+        top = frameTop;
+        right = frameRight;
+        bottom = frameBottom;
+        anyFound = true;
+        continue;
+      }
+
+      left = std::min(left, frameLeft);
+      top = std::min(top, frameTop);
+      right = std::max(right, frameRight);
+      bottom = std::max(bottom, frameBottom);
+    }
+  }
+
+  int trimmedWidth = right - left + 1;
+  int trimmedHeight = bottom - top + 1;
+  size_t frameSize = trimmedWidth * trimmedHeight * 4;
+
+  PixelBuffer pixels(frameSize * numFrames);
+  for (int frameIdx = 0; frameIdx < numFrames; ++frameIdx) {
+    PixelOps::copyRegion(
+      frames[frameIdx].pixels.data(),
+      width,
+      left,
+      top,
+      trimmedWidth,
+      trimmedHeight,
+      pixels.data() + frameIdx * frameSize
+    );
+  }
+
+  RenderResult result(pixels, trimmedWidth, trimmedHeight * numFrames);
+  result.offsetX += left;
+  result.offsetY += top;
+  return result;
 }
 
 RenderResult Renderer::renderSlider(
@@ -294,30 +418,40 @@ RenderResult Renderer::renderSlider(
     );
   hideChildren(framebuffer);
 
+  if (!showSliderLayer(paramWidget, framebuffer, breadcrumbs.textureType))
+    return RenderResult();
+
+  rack::math::Vec scale = getScaleFromRecipe(framebuffer, recipe);
+  return Renderer(framebuffer).render(scale, recipe.trim);
+}
+
+bool Renderer::showSliderLayer(
+  rack::app::ParamWidget* paramWidget,
+  rack::widget::FramebufferWidget* framebuffer,
+  TextureType textureType
+) {
   rack::app::SvgSlider* sliderWidget =
     dynamic_cast<rack::app::SvgSlider*>(paramWidget);
+  if (!sliderWidget) return false;
+
   rack::widget::Widget* track = sliderWidget->background;
   rack::widget::Widget* handle = sliderWidget->handle;
 
-  if (track && breadcrumbs.textureType == TextureType::Slider_track) {
+  if (track && textureType == TextureType::Slider_track) {
     track->visible = true;
     framebuffer->box.size = track->box.size;
-    rack::math::Vec scale = getScaleFromRecipe(framebuffer, recipe);
     if (handle) handle->visible = false;
-
-    return Renderer(framebuffer).render(scale);
+    return true;
   }
 
-  if (handle && breadcrumbs.textureType == TextureType::Slider_handle) {
+  if (handle && textureType == TextureType::Slider_handle) {
     if (track) track->visible = false;
     handle->visible = true;
     framebuffer->box.size = handle->box.size;
-    rack::math::Vec scale = getScaleFromRecipe(framebuffer, recipe);
-
-    return Renderer(framebuffer).render(scale);
+    return true;
   }
 
-  return RenderResult();
+  return false;
 }
 
 RenderResult Renderer::renderKnob(
@@ -335,6 +469,17 @@ RenderResult Renderer::renderKnob(
     );
   hideChildren(framebuffer);
 
+  if (!showKnobLayer(framebuffer, breadcrumbs.textureType))
+    return RenderResult();
+
+  rack::math::Vec scale = getScaleFromRecipe(framebuffer, recipe);
+  return Renderer(framebuffer).render(scale, recipe.trim);
+}
+
+bool Renderer::showKnobLayer(
+  rack::widget::FramebufferWidget* framebuffer,
+  TextureType textureType
+) {
   rack::widget::Widget* bg{NULL};
   rack::widget::Widget* mg{NULL};
   rack::widget::Widget* fg{NULL};
@@ -358,33 +503,28 @@ RenderResult Renderer::renderKnob(
     lastWidget = child;
   }
 
-  rack::math::Vec scale = getScaleFromRecipe(framebuffer, recipe);
-
-  if (bg && breadcrumbs.textureType == TextureType::Knob_bg) {
+  if (bg && textureType == TextureType::Knob_bg) {
     bg->visible = true;
     if (mg) mg->visible = false;
     if (fg) fg->visible = false;
-
-    return Renderer(framebuffer).render(scale);
+    return true;
   }
 
-  if (mg && breadcrumbs.textureType == TextureType::Knob_mg) {
+  if (mg && textureType == TextureType::Knob_mg) {
     if (bg) bg->visible = false;
     mg->visible = true;
     if (fg) fg->visible = false;
-
-    return Renderer(framebuffer).render(scale);
+    return true;
   }
 
-  if (fg && breadcrumbs.textureType == TextureType::Knob_fg) {
+  if (fg && textureType == TextureType::Knob_fg) {
     if (bg) bg->visible = false;
     if (mg) mg->visible = false;
     fg->visible = true;
-
-    return Renderer(framebuffer).render(scale);
+    return true;
   }
 
-  return RenderResult();
+  return false;
 }
 
 RenderResult Renderer::renderPort(
@@ -403,7 +543,139 @@ RenderResult Renderer::renderPort(
   hideChildren(framebuffer);
 
   rack::math::Vec scale = getScaleFromRecipe(framebuffer, recipe);
-  return Renderer(framebuffer).render(scale);
+  return Renderer(framebuffer).render(scale, recipe.trim);
+}
+
+bool Renderer::prepareRaster(
+  const Breadcrumbs& breadcrumbs,
+  const Recipe& recipe,
+  RasterJob& job
+) {
+  switch (breadcrumbs.textureType) {
+    case TextureType::Knob_bg:
+    case TextureType::Knob_mg:
+    case TextureType::Knob_fg:
+    case TextureType::Slider_track:
+    case TextureType::Slider_handle:
+    case TextureType::Switch_frame:
+    case TextureType::Port_input:
+    case TextureType::Port_output:
+      break;
+    default:
+      // panels, overlays and switch strips always render through GL
+      return false;
+  }
+
+  // regions need the wrapper's offset, only GL does that
+  if (recipe.hasRegion()) return false;
+
+  rack::plugin::Model* model =
+    gtnosft::util::findModel(breadcrumbs.pluginSlug, breadcrumbs.moduleSlug);
+  if (!model) return false;
+
+  // switch frames come straight from SvgSwitch::frames, no module needed
+  rack::app::ModuleWidget* moduleWidget = gtnosft::util::makeModuleWidget(model);
+  if (!moduleWidget) return false;
+  DEFER({ delete moduleWidget; });
+
+  rack::widget::Widget* component{NULL};
+  switch (breadcrumbs.textureType) {
+    case TextureType::Port_input:
+      component = moduleWidget->getInput(breadcrumbs.componentId);
+      break;
+    case TextureType::Port_output:
+      component = moduleWidget->getOutput(breadcrumbs.componentId);
+      break;
+    default:
+      component = moduleWidget->getParam(breadcrumbs.componentId);
+      break;
+  }
+  if (!component) return false;
+
+  rack::widget::FramebufferWidget* framebuffer = findFramebuffer(component);
+  if (!framebuffer) return false;
+  hideChildren(framebuffer);
+
+  switch (breadcrumbs.textureType) {
+    case TextureType::Knob_bg:
+    case TextureType::Knob_mg:
+    case TextureType::Knob_fg:
+      if (!showKnobLayer(framebuffer, breadcrumbs.textureType)) return false;
+      break;
+    case TextureType::Slider_track:
+    case TextureType::Slider_handle:
+      if (
+        !showSliderLayer(
+          dynamic_cast<rack::app::ParamWidget*>(component),
+          framebuffer,
+          breadcrumbs.textureType
+        )
+      ) return false;
+      break;
+    case TextureType::Switch_frame: {
+      rack::app::SvgSwitch* switchWidget =
+        dynamic_cast<rack::app::SvgSwitch*>(component);
+      if (!switchWidget || switchWidget->frames.empty()) return false;
+
+      size_t frameIdx =
+        std::min<size_t>(breadcrumbs.frameIdx, switchWidget->frames.size() - 1);
+      switchWidget->sw->setSvg(switchWidget->frames[frameIdx]);
+      break;
+    }
+    default:
+      break;
+  }
+
+  if (!collectSvgLayers(framebuffer, rack::math::Vec(0, 0), job.layers))
+    return false;
+
+  rack::math::Vec size = framebuffer->box.size;
+  if (size.x <= 0.f || size.y <= 0.f) return false;
+
+  // same output size renderPixels settles on
+  rack::math::Vec scale = getScaleFromRecipe(framebuffer, recipe);
+  float pixelRatio = std::fmax(1.f, std::floor(APP->window->pixelRatio));
+  job.width = (int)std::ceil(std::ceil(size.x * scale.x) * pixelRatio);
+  job.height = (int)std::ceil(std::ceil(size.y * scale.y) * pixelRatio);
+  job.scale = rack::math::Vec(job.width / size.x, job.height / size.y);
+  job.trim = recipe.trim;
+
+  return true;
+}
+
+bool Renderer::collectSvgLayers(
+  rack::widget::Widget* parent,
+  rack::math::Vec offset,
+  std::vector<RasterLayer>& layers
+) {
+  static const float IDENTITY[6]{1.f, 0.f, 0.f, 1.f, 0.f, 0.f};
+
+  for (rack::widget::Widget* child : parent->children) {
+    if (!child->isVisible()) continue;
+    rack::math::Vec childOffset = offset.plus(child->box.pos);
+
+    rack::widget::SvgWidget* svgWidget =
+      dynamic_cast<rack::widget::SvgWidget*>(child);
+    rack::widget::TransformWidget* transformWidget =
+      dynamic_cast<rack::widget::TransformWidget*>(child);
+
+    if (svgWidget) {
+      if (svgWidget->svg && svgWidget->svg->handle) {
+        if (!SvgRasterizer::supports(svgWidget->svg->handle)) return false;
+        layers.emplace_back(svgWidget->svg, childOffset);
+      }
+    } else if (transformWidget) {
+      if (!std::equal(transformWidget->transform, transformWidget->transform + 6, IDENTITY))
+        return false;
+    } else {
+      // custom drawing, leave it to GL
+      return false;
+    }
+
+    if (!collectSvgLayers(child, childOffset, layers)) return false;
+  }
+
+  return true;
 }
 
 rack::widget::FramebufferWidget* Renderer::findFramebuffer(
@@ -421,12 +693,16 @@ Renderer::Renderer(rack::widget::FramebufferWidget* _framebuffer):
   framebuffer(_framebuffer) {}
 Renderer::~Renderer() {}
 
-RenderResult Renderer::render(rack::math::Vec scale) {
+RenderResult Renderer::render(rack::math::Vec scale, bool trim) {
   try {
     int width, height;
-    uint8_t* pixels = renderPixels(framebuffer, width, height, scale);
+    // untrimmed renders are read back top row first, trimming needs the
+    // whole image anyway and flips while it crops
+    PixelBuffer pixels = renderPixels(framebuffer, width, height, scale, !trim);
 
-    return RenderResult(pixels, width, height);
+    RenderResult result(pixels, width, height);
+    if (trim) trimFlipped(result);
+    return result;
   } catch (std::exception& e) {
     return RenderResult(e.what());
   } catch (...) {
@@ -449,6 +725,24 @@ rack::widget::FramebufferWidget* Renderer::wrapForRendering(
   return fbcontainer;
 }
 
+rack::widget::FramebufferWidget* Renderer::wrapRegionForRendering(
+  rack::widget::Widget* widget,
+  rack::math::Rect region
+) {
+  region = region.intersect(widget->box.zeroPos());
+  if (region.size.x <= 0.f || region.size.y <= 0.f) return NULL;
+
+  rack::widget::FramebufferWidget* fbcontainer = wrapForRendering(widget);
+
+  // the framebuffer is sized by its children's bounding box, which is the
+  // container, so everything outside the region is never drawn
+  fbcontainer->box.size = region.size;
+  fbcontainer->children.front()->box.size = region.size;
+  widget->box.pos = region.pos.neg();
+
+  return fbcontainer;
+}
+
 void Renderer::removeFromWrapper(
   rack::widget::FramebufferWidget* fb,
   rack::widget::Widget* widget
@@ -491,11 +785,12 @@ rack::math::Vec Renderer::getScaleFromRecipe(
   }
 }
 
-uint8_t* Renderer::renderPixels(
+PixelBuffer Renderer::renderPixels(
   rack::widget::FramebufferWidget* fb,
   int& width,
   int& height,
   rack::math::Vec scale,
+  bool topDown,
   bool override
 ) {
   fb->render(scale);
@@ -524,27 +819,142 @@ uint8_t* Renderer::renderPixels(
         width,
         height,
         scaleOverride,
+        topDown,
         true
       );
     }
   }
 
-  uint8_t* pixels = new uint8_t[height * width * 4];
-  glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
-  flipBitmap(pixels, width, height, 4);
+  PixelBuffer pixels(height * width * 4);
+  if (topDown) {
+    // one row per read, each landing in its flipped slot, so there's no
+    // separate flip pass over the whole image afterwards
+    size_t rowSize = (size_t)width * 4;
+    for (int y = 0; y < height; ++y) {
+      glReadPixels(
+        0, y, width, 1, GL_RGBA, GL_UNSIGNED_BYTE,
+        pixels.data() + (height - y - 1) * rowSize
+      );
+    }
+  } else {
+    // bottom row first, as GL has it
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+  }
 
   nvgluBindFramebuffer(NULL);
   return pixels;
 }
 
-void Renderer::flipBitmap(uint8_t* pixels, int width, int height, int depth) {
-  for (int y = 0; y < height / 2; y++) {
-    int flipY = height - y - 1;
-    uint8_t tmp[width * depth];
-    std::memcpy(tmp, &pixels[y * width * depth], width * depth);
-    std::memcpy(&pixels[y * width * depth], &pixels[flipY * width * depth], width * depth);
-    std::memcpy(&pixels[flipY * width * depth], tmp, width * depth);
+void Renderer::trimBitmap(RenderResult& result) {
+  if (!result.success()) return;
+
+  int left, top, right, bottom;
+  bool found = PixelOps::findAlphaBounds(
+    result.pixels.data(),
+    result.width,
+    result.height,
+    left,
+    top,
+    right,
+    bottom
+  );
+
+  // nothing to trim, or nothing left to send
+  if (!found) return;
+  int width = right - left + 1;
+  int height = bottom - top + 1;
+  if (width == result.width && height == result.height) return;
+
+  PixelBuffer pixels(width * height * 4);
+  PixelOps::copyRegion(
+    result.pixels.data(),
+    result.width,
+    left,
+    top,
+    width,
+    height,
+    pixels.data()
+  );
+
+  result.pixels = pixels;
+  result.offsetX += left;
+  result.offsetY += top;
+  result.width = width;
+  result.height = height;
+}
+
+void Renderer::trimFlipped(RenderResult& result) {
+  int left, top, right, bottom;
+  bool found = PixelOps::findAlphaBounds(
+    result.pixels.data(),
+    result.width,
+    result.height,
+    left,
+    top,
+    right,
+    bottom
+  );
+
+  // nothing left to send, the bounds aren't set. every pixel is clear, so
+  // row order doesn't matter
+  if (!found) return;
+
+  // crop and flip in the same pass, a full size region is a plain flip
+  int width = right - left + 1;
+  int height = bottom - top + 1;
+  PixelBuffer pixels(width * height * 4);
+  PixelOps::copyRegion(
+    result.pixels.data(),
+    result.width,
+    left,
+    top,
+    width,
+    height,
+    pixels.data(),
+    true
+  );
+
+  result.pixels = pixels;
+  result.offsetX += left;
+  // the lowest alpha row in GL's order is the top one once flipped
+  result.offsetY += result.height - bottom - 1;
+  result.width = width;
+  result.height = height;
+}
+
+RenderResult Renderer::downsampleBitmap(const RenderResult& result, int factor) {
+  int width = std::max(1, (result.width + factor - 1) / factor);
+  int height = std::max(1, (result.height + factor - 1) / factor);
+  PixelBuffer pixels(width * height * 4);
+
+  // premultiplied, so a plain average of each channel is right
+  for (int y = 0; y < height; ++y) {
+    int top = y * factor;
+    int bottom = std::min(top + factor, result.height);
+
+    for (int x = 0; x < width; ++x) {
+      int left = x * factor;
+      int right = std::min(left + factor, result.width);
+
+      uint32_t sums[4]{0, 0, 0, 0};
+      for (int sy = top; sy < bottom; ++sy) {
+        const uint8_t* src =
+          result.pixels.data() + (sy * result.width + left) * 4;
+        for (int sx = left; sx < right; ++sx, src += 4) {
+          sums[0] += src[0];
+          sums[1] += src[1];
+          sums[2] += src[2];
+          sums[3] += src[3];
+        }
+      }
+
+      uint32_t count = (bottom - top) * (right - left);
+      uint8_t* dst = pixels.data() + (y * width + x) * 4;
+      for (int c = 0; c < 4; ++c) dst[c] = (sums[c] + count / 2) / count;
+    }
   }
+
+  return RenderResult(pixels, width, height);
 }
 
 std::string Renderer::makeFilename(rack::app::ModuleWidget* mw) {
@@ -3,6 +3,9 @@
 #include "rack.hpp"
 #include <variant>
 
+#include "PixelFormat.hpp"
+#include "../util/BufferPool.hpp"
+
 struct WidgetContainer : rack::widget::Widget {
   void draw(const DrawArgs& args) override {
     Widget::draw(args);
@@ -27,11 +30,24 @@ enum class RenderType {
 enum class TextureType;
 struct Breadcrumbs;
 
+// SvgRasterizer
+struct RasterJob;
+struct RasterLayer;
+
 struct Recipe {
 	RenderType type{RenderType::Unknown};
 	float scale{-1.f};
 	int32_t height{-1};
 	int32_t width{-1};
+	// crop transparent borders after readback
+	bool trim{false};
+	// what the pixels are converted to for sending, see PixelFormat
+	PixelFormat::Id format{PixelFormat::RGBA8888};
+	// render only this part of the widget, in cm from its top left.
+	// scale or height/width apply to the region. panels only.
+	rack::math::Rect region;
+
+	bool hasRegion() const { return !region.size.isZero(); }
 
 	Recipe() = default;
 	Recipe(float _scale): type(RenderType::Scaled), scale(_scale) {};
@@ -41,29 +57,41 @@ struct Recipe {
 };
 
 struct RenderResult {
-  uint8_t* pixels;
+  // shared, freed with the last copy of the result
+  PixelBuffer pixels;
   int width;
   int height;
 
+  // position and size of the full render if pixels were trimmed
+  int offsetX{0};
+  int offsetY{0};
+  int originalWidth{0};
+  int originalHeight{0};
+
   RenderStatus status{RenderStatus::Unknown};
   std::string statusMessage{""};
 
-  bool success() {
+  bool success() const {
     return status == RenderStatus::Success;
   }
 
-  bool failure() {
+  bool failure() const {
     return status == RenderStatus::Failure;
   }
 
-  bool empty() {
+  bool empty() const {
     return status == RenderStatus::Empty;
   }
 
   RenderResult(): status(RenderStatus::Empty) {}
 
-  RenderResult(uint8_t* pixels, int width, int height):
-    pixels(pixels), width(width), height(height), status(RenderStatus::Success) {}
+  RenderResult(PixelBuffer pixels, int width, int height):
+    pixels(pixels),
+    width(width),
+    height(height),
+    originalWidth(width),
+    originalHeight(height),
+    status(RenderStatus::Success) {}
 
   RenderResult(const std::string& _statusMessage)
     : status(RenderStatus::Failure), statusMessage(_statusMessage) {}
@@ -73,7 +101,8 @@ struct Renderer {
   Renderer(rack::widget::FramebufferWidget* framebuffer);
   ~Renderer();
 
-  RenderResult render(rack::math::Vec scale);
+  // trims in the same pass that flips GL's bottom-up rows
+  RenderResult render(rack::math::Vec scale, bool trim = false);
 
   rack::widget::FramebufferWidget* framebuffer = NULL;
 
@@ -92,6 +121,11 @@ struct Renderer {
 
   static RenderResult OVERLAY_BLOCKLISTED(std::string caller, int64_t moduleId);
 
+  static RenderResult REGION_UNSUPPORTED(
+    std::string caller,
+    const Breadcrumbs& breadcrumbs
+  );
+
   static RenderResult MODULE_WIDGET_ERROR(
     std::string caller,
     const std::string& pluginSlug,
@@ -120,6 +154,8 @@ struct Renderer {
     const Recipe& recipe
   );
 
+  static bool isOverlayBlocklisted(rack::app::ModuleWidget* moduleWidget);
+
   static RenderResult renderKnob(
 		rack::app::ParamWidget* knobWidget,
     const Breadcrumbs& breadcrumbs,
@@ -132,6 +168,13 @@ struct Renderer {
 		const Recipe& recipe
   );
 
+  // every frame of a switch, top to bottom, in a single image
+  static RenderResult renderSwitchStrip(
+		rack::app::ParamWidget* switchWidget,
+    const Breadcrumbs& breadcrumbs,
+		const Recipe& recipe
+  );
+
   static RenderResult renderSlider(
 		rack::app::ParamWidget* paramWidget,
     const Breadcrumbs& breadcrumbs,
@@ -144,6 +187,34 @@ struct Renderer {
 		const Recipe& recipe
   );
 
+  // show only the knob layer for a texture type, false if there isn't one
+  static bool showKnobLayer(
+    rack::widget::FramebufferWidget* framebuffer,
+    TextureType textureType
+  );
+
+  // show only the slider layer for a texture type, false if there isn't one
+  static bool showSliderLayer(
+    rack::app::ParamWidget* paramWidget,
+    rack::widget::FramebufferWidget* framebuffer,
+    TextureType textureType
+  );
+
+  // gather what SvgRasterizer needs to draw a texture off the UI thread.
+  // false if the texture needs GL (panels, overlays, custom drawn widgets).
+  static bool prepareRaster(
+    const Breadcrumbs& breadcrumbs,
+    const Recipe& recipe,
+    RasterJob& job
+  );
+
+  // visible svgs under a widget, false if anything visible isn't an svg
+  static bool collectSvgLayers(
+    rack::widget::Widget* parent,
+    rack::math::Vec offset,
+    std::vector<RasterLayer>& layers
+  );
+
   static rack::widget::FramebufferWidget* findFramebuffer(
     rack::widget::Widget* widget
   );
@@ -152,18 +223,26 @@ struct Renderer {
   static rack::widget::FramebufferWidget* wrapForRendering(
     rack::widget::Widget* widget
   );
+  // wrap with only region (px) of the widget in the framebuffer, the widget
+  // is offset so the region's top left lands at the framebuffer's origin
+  static rack::widget::FramebufferWidget* wrapRegionForRendering(
+    rack::widget::Widget* widget,
+    rack::math::Rect region
+  );
   // call removeChild on inner container
   static void removeFromWrapper(
     rack::widget::FramebufferWidget* fb,
     rack::widget::Widget* widget
   );
 
-  // render framebuffer to pixel array
-  uint8_t* renderPixels(
+  // render framebuffer to pixel array, top row first if topDown, otherwise
+  // in GL's bottom-up order
+  PixelBuffer renderPixels(
     rack::widget::FramebufferWidget* fb,
     int& width,
     int& height,
     rack::math::Vec scale,
+    bool topDown,
     bool override = false
   );
 
@@ -201,5 +280,10 @@ struct Renderer {
     std::function<bool(rack::widget::Widget*)>
   > hideChildrenVisibilityOverride;
 
-  void flipBitmap(uint8_t* pixels, int width, int height, int depth);
+  // crop a successful render to the bounding box of its non-transparent pixels
+  static void trimBitmap(RenderResult& result);
+  // trimBitmap for a render still in GL's bottom-up row order, flips it
+  static void trimFlipped(RenderResult& result);
+  // box filtered copy, 1/factor the size (rounded up)
+  static RenderResult downsampleBitmap(const RenderResult& result, int factor);
 };
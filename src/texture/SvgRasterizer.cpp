@@ -0,0 +1,140 @@
+#include "SvgRasterizer.hpp"
+
+#include <cstring>
+#include <memory>
+
+#define NANOSVGRAST_IMPLEMENTATION
+#include "nanosvg/nanosvgrast.h"
+
+namespace {
+
+struct RasterizerDeleter {
+  void operator()(NSVGrasterizer* rasterizer) const {
+    nsvgDeleteRasterizer(rasterizer);
+  }
+};
+
+// one per worker thread, it keeps its edge and scanline buffers across jobs
+thread_local std::unique_ptr<NSVGrasterizer, RasterizerDeleter> rasterizer;
+
+NSVGrasterizer* getRasterizer() {
+  if (!rasterizer) rasterizer.reset(nsvgCreateRasterizer());
+  return rasterizer.get();
+}
+
+// nanosvgrast hands back straight alpha
+void premultiply(uint8_t* pixels, size_t pixelCount) {
+  for (size_t i = 0; i < pixelCount; ++i, pixels += 4) {
+    uint32_t alpha = pixels[3];
+    if (alpha == 255) continue;
+    pixels[0] = (pixels[0] * alpha + 127) / 255;
+    pixels[1] = (pixels[1] * alpha + 127) / 255;
+    pixels[2] = (pixels[2] * alpha + 127) / 255;
+  }
+}
+
+} // namespace
+
+bool SvgRasterizer::supports(const NSVGimage* image) {
+  if (!image) return false;
+
+  for (NSVGshape* shape = image->shapes; shape; shape = shape->next) {
+    if (!(shape->flags & NSVG_FLAGS_VISIBLE)) continue;
+    if (shape->stroke.type != NSVG_PAINT_NONE && shape->strokeDashCount > 0)
+      return false;
+  }
+
+  return true;
+}
+
+RenderResult SvgRasterizer::render(const RasterJob& job) {
+  if (job.width < 1 || job.height < 1)
+    return RenderResult("SvgRasterizer::render empty raster job");
+
+  size_t pixelCount = (size_t)job.width * job.height;
+  PixelBuffer pixels(pixelCount * 4);
+  if (job.layers.empty()) std::memset(pixels.data(), 0, pixels.size());
+
+  // the first layer draws straight into the output, the rest go through a
+  // scratch buffer since nanosvgrast clears what it draws into
+  PixelBuffer layerPixels;
+  for (size_t i = 0; i < job.layers.size(); ++i) {
+    const RasterLayer& layer = job.layers[i];
+
+    if (i == 0) {
+      rasterize(
+        layer.svg->handle,
+        layer.offset,
+        job.scale,
+        pixels.data(),
+        job.width,
+        job.height
+      );
+      continue;
+    }
+
+    if (!layerPixels) layerPixels = PixelBuffer(pixelCount * 4);
+    rasterize(
+      layer.svg->handle,
+      layer.offset,
+      job.scale,
+      layerPixels.data(),
+      job.width,
+      job.height
+    );
+    composite(layerPixels.data(), pixels.data(), pixelCount);
+  }
+
+  RenderResult result(pixels, job.width, job.height);
+  if (job.trim) Renderer::trimBitmap(result);
+  return result;
+}
+
+void SvgRasterizer::rasterize(
+  const NSVGimage* image,
+  rack::math::Vec offset,
+  rack::math::Vec scale,
+  uint8_t* pixels,
+  int width,
+  int height
+) {
+  NSVGrasterizer* rast = getRasterizer();
+  if (!rast) {
+    std::memset(pixels, 0, (size_t)width * height * 4);
+    return;
+  }
+
+  // nanosvgrast translates after scaling
+  nsvgRasterizeXY(
+    rast,
+    const_cast<NSVGimage*>(image),
+    offset.x * scale.x,
+    offset.y * scale.y,
+    scale.x,
+    scale.y,
+    pixels,
+    width,
+    height,
+    width * 4
+  );
+  premultiply(pixels, (size_t)width * height);
+}
+
+void SvgRasterizer::composite(
+  const uint8_t* src,
+  uint8_t* dst,
+  size_t pixelCount
+) {
+  for (size_t i = 0; i < pixelCount; ++i, src += 4, dst += 4) {
+    uint32_t alpha = src[3];
+    if (alpha == 0) continue;
+    if (alpha == 255) {
+      std::memcpy(dst, src, 4);
+      continue;
+    }
+
+    uint32_t inverse = 255 - alpha;
+    for (int c = 0; c < 4; ++c)
+      dst[c] = src[c] + (dst[c] * inverse + 127) / 255;
+  }
+}
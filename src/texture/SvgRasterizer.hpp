@@ -0,0 +1,53 @@
+#pragma once
+
+#include "rack.hpp"
+
+#include <memory>
+#include <vector>
+
+#include "Renderer.hpp"
+
+// an svg drawn at an offset within the rendered widget, in widget px
+struct RasterLayer {
+  std::shared_ptr<rack::window::Svg> svg;
+  rack::math::Vec offset;
+
+  RasterLayer(std::shared_ptr<rack::window::Svg> _svg, rack::math::Vec _offset):
+    svg(_svg), offset(_offset) {}
+};
+
+// everything needed to draw a texture without the widget or the GL context,
+// gathered on the UI thread and safe to hand to another thread
+struct RasterJob {
+  std::vector<RasterLayer> layers;
+  int width{0};
+  int height{0};
+  // widget px to device px
+  rack::math::Vec scale;
+  bool trim{false};
+};
+
+// CPU rasterizer for nanosvg images, nanosvgrast underneath. output matches
+// what Renderer reads back from a framebuffer: premultiplied RGBA, top row
+// first.
+struct SvgRasterizer {
+  // false if the image uses anything Rack wouldn't draw the same way. Rack
+  // draws dashed strokes solid, nanosvgrast dashes them.
+  static bool supports(const NSVGimage* image);
+
+  static RenderResult render(const RasterJob& job);
+
+  // draw an image into a width x height premultiplied RGBA buffer, replacing
+  // whatever was there
+  static void rasterize(
+    const NSVGimage* image,
+    rack::math::Vec offset,
+    rack::math::Vec scale,
+    uint8_t* pixels,
+    int width,
+    int height
+  );
+
+  // source over, both premultiplied
+  static void composite(const uint8_t* src, uint8_t* dst, size_t pixelCount);
+};
@@ -0,0 +1,80 @@
+#include "TextureCache.hpp"
+#include "Catalog.hpp"
+
+bool TextureCache::isCacheable(int64_t textureId, const Recipe& recipe) {
+  if (recipe.hasRegion()) return false;
+
+  switch (Catalog::getTextureType(textureId)) {
+    case TextureType::Unknown:
+    case TextureType::Overlay:
+      return false;
+    default:
+      return true;
+  }
+}
+
+TextureCacheKey TextureCache::makeKey(
+  int64_t textureId,
+  const Recipe& recipe,
+  ImageCodec::Id codec
+) {
+  TextureCacheKey key;
+  key.textureId = textureId;
+  key.type = recipe.type;
+  key.scale = recipe.scale;
+  key.height = recipe.height;
+  key.width = recipe.width;
+  key.trim = recipe.trim;
+  key.format = recipe.format;
+  // textures can't be delta encoded, they're sent as lz4 either way
+  key.codec = codec == ImageCodec::DELTA ? ImageCodec::LZ4 : codec;
+  // themed panels and components render differently
+  key.darkPanels = rack::settings::preferDarkPanels;
+  return key;
+}
+
+bool TextureCache::contains(const TextureCacheKey& key) {
+  return index.contains(key);
+}
+
+bool TextureCache::get(const TextureCacheKey& key, EncodedTexture& encoded) {
+  auto found = index.find(key);
+  if (found == index.end()) return false;
+
+  entries.splice(entries.begin(), entries, found->second);
+  encoded = found->second->second;
+  return true;
+}
+
+void TextureCache::put(const TextureCacheKey& key, const EncodedTexture& encoded) {
+  // one texture that big would push out everything else
+  if ((size_t)encoded.size > MAX_BYTES / 4) return;
+
+  auto found = index.find(key);
+  if (found != index.end()) {
+    totalBytes -= found->second->second.size;
+    entries.erase(found->second);
+    index.erase(found);
+  }
+
+  entries.emplace_front(key, encoded);
+  index.emplace(key, entries.begin());
+  totalBytes += encoded.size;
+
+  evict();
+}
+
+void TextureCache::clear() {
+  entries.clear();
+  index.clear();
+  totalBytes = 0;
+}
+
+void TextureCache::evict() {
+  while (totalBytes > MAX_BYTES && !entries.empty()) {
+    Entry& oldest = entries.back();
+    totalBytes -= oldest.second.size;
+    index.erase(oldest.first);
+    entries.pop_back();
+  }
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "rack.hpp"
+
+#include <list>
+#include <map>
+#include <tuple>
+
+#include "Renderer.hpp"
+#include "ImageCodec.hpp"
+#include "PixelFormat.hpp"
+#include "../util/BufferPool.hpp"
+
+// a texture as it goes out in /set/texture, already converted and encoded
+struct EncodedTexture {
+  PixelBuffer data;
+  int64_t size{0};
+
+  int32_t width{0};
+  int32_t height{0};
+  int32_t offsetX{0};
+  int32_t offsetY{0};
+  int32_t originalWidth{0};
+  int32_t originalHeight{0};
+
+  ImageCodec::Id codec{ImageCodec::QOI};
+  PixelFormat::Id format{PixelFormat::RGBA8888};
+  uint32_t tint{0};
+};
+
+// everything that changes a texture's encoded bytes
+struct TextureCacheKey {
+  int64_t textureId{-1};
+  RenderType type{RenderType::Unknown};
+  float scale{-1.f};
+  int32_t height{-1};
+  int32_t width{-1};
+  bool trim{false};
+  int32_t format{0};
+  int32_t codec{0};
+  bool darkPanels{false};
+
+  bool operator<(const TextureCacheKey& other) const {
+    return std::tie(
+      textureId, type, scale, height, width, trim, format, codec, darkPanels
+    ) < std::tie(
+      other.textureId,
+      other.type,
+      other.scale,
+      other.height,
+      other.width,
+      other.trim,
+      other.format,
+      other.codec,
+      other.darkPanels
+    );
+  }
+};
+
+// least recently used encoded textures, so repeat requests skip the render
+// and the encode. ui thread only, like Catalog.
+struct TextureCache {
+  static const size_t MAX_BYTES{64 << 20};
+
+  // false for textures that change without their id changing (overlays) or
+  // recipes that aren't worth keeping (regions)
+  static bool isCacheable(int64_t textureId, const Recipe& recipe);
+
+  static TextureCacheKey makeKey(
+    int64_t textureId,
+    const Recipe& recipe,
+    ImageCodec::Id codec
+  );
+
+  static bool contains(const TextureCacheKey& key);
+  static bool get(const TextureCacheKey& key, EncodedTexture& encoded);
+  static void put(const TextureCacheKey& key, const EncodedTexture& encoded);
+  static void clear();
+
+private:
+  typedef std::pair<TextureCacheKey, EncodedTexture> Entry;
+
+  // most recently used first
+  static inline std::list<Entry> entries;
+  static inline std::map<TextureCacheKey, std::list<Entry>::iterator> index;
+  static inline size_t totalBytes{0};
+
+  static void evict();
+};
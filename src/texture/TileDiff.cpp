@@ -0,0 +1,88 @@
+#include "TileDiff.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+int32_t TileDiff::tilesPerRow(int32_t width) {
+  return (width + TILE_SIZE - 1) / TILE_SIZE;
+}
+
+int32_t TileDiff::tilesPerColumn(int32_t height) {
+  return (height + TILE_SIZE - 1) / TILE_SIZE;
+}
+
+void TileDiff::findChangedTiles(
+  const uint8_t* previous,
+  const uint8_t* current,
+  int32_t width,
+  int32_t height,
+  std::vector<uint32_t>& tiles
+) {
+  int32_t columns = tilesPerRow(width);
+  int32_t rows = tilesPerColumn(height);
+  std::vector<bool> changed(columns);
+
+  for (int32_t tileY = 0; tileY < rows; ++tileY) {
+    std::fill(changed.begin(), changed.end(), false);
+    int32_t numChanged{0};
+
+    int32_t top = tileY * TILE_SIZE;
+    int32_t bottom = std::min(top + TILE_SIZE, height);
+
+    // walk each pixel row once, only comparing tiles not yet known to differ
+    for (int32_t y = top; y < bottom && numChanged < columns; ++y) {
+      size_t rowOffset = (size_t)y * width * 4;
+
+      for (int32_t tileX = 0; tileX < columns; ++tileX) {
+        if (changed[tileX]) continue;
+
+        int32_t left = tileX * TILE_SIZE;
+        int32_t tileWidth = std::min(TILE_SIZE, width - left);
+        size_t offset = rowOffset + left * 4;
+
+        if (std::memcmp(previous + offset, current + offset, tileWidth * 4)) {
+          changed[tileX] = true;
+          ++numChanged;
+        }
+      }
+    }
+
+    for (int32_t tileX = 0; tileX < columns; ++tileX)
+      if (changed[tileX]) tiles.push_back(tileY * columns + tileX);
+  }
+}
+
+void TileDiff::allTiles(int32_t width, int32_t height, std::vector<uint32_t>& tiles) {
+  uint32_t numTiles = tilesPerRow(width) * tilesPerColumn(height);
+  for (uint32_t tile = 0; tile < numTiles; ++tile) tiles.push_back(tile);
+}
+
+PixelBuffer TileDiff::packTiles(
+  const uint8_t* pixels,
+  int32_t width,
+  int32_t height,
+  const std::vector<uint32_t>& tiles
+) {
+  int32_t columns = tilesPerRow(width);
+  size_t tileBytes = TILE_SIZE * TILE_SIZE * 4;
+  PixelBuffer strip(tileBytes * tiles.size());
+  std::memset(strip.data(), 0, strip.size());
+
+  for (size_t i = 0; i < tiles.size(); ++i) {
+    int32_t left = (tiles[i] % columns) * TILE_SIZE;
+    int32_t top = (tiles[i] / columns) * TILE_SIZE;
+    int32_t tileWidth = std::min(TILE_SIZE, width - left);
+    int32_t tileHeight = std::min(TILE_SIZE, height - top);
+
+    uint8_t* dst = strip.data() + i * tileBytes;
+    for (int32_t y = 0; y < tileHeight; ++y) {
+      std::memcpy(
+        dst + y * TILE_SIZE * 4,
+        pixels + ((size_t)(top + y) * width + left) * 4,
+        tileWidth * 4
+      );
+    }
+  }
+
+  return strip;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "rack.hpp"
+
+#include <vector>
+
+#include "../util/BufferPool.hpp"
+
+// splits RGBA frames into square tiles to find and pack what changed
+struct TileDiff {
+  static constexpr int32_t TILE_SIZE{32};
+
+  static int32_t tilesPerRow(int32_t width);
+  static int32_t tilesPerColumn(int32_t height);
+
+  // row-major indices of tiles that differ between two same-sized frames
+  static void findChangedTiles(
+    const uint8_t* previous,
+    const uint8_t* current,
+    int32_t width,
+    int32_t height,
+    std::vector<uint32_t>& tiles
+  );
+
+  // every tile index in a frame
+  static void allTiles(int32_t width, int32_t height, std::vector<uint32_t>& tiles);
+
+  // tiles stacked top to bottom in a TILE_SIZE wide strip, tiles cut off by
+  // the frame's right/bottom edge are padded with transparent pixels
+  static PixelBuffer packTiles(
+    const uint8_t* pixels,
+    int32_t width,
+    int32_t height,
+    const std::vector<uint32_t>& tiles
+  );
+};
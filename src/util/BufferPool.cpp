@@ -0,0 +1,120 @@
+#include "BufferPool.hpp"
+
+#include <bit>
+
+size_t BufferPool::capacityFor(size_t size) {
+  if (size <= MIN_CAPACITY) return MIN_CAPACITY;
+  if (size > MAX_CAPACITY) return size;
+
+  // size is in (2^(bits - 1), 2^bits], split that range in four
+  size_t bits = std::bit_width(size - 1);
+  size_t step = (size_t)1 << (bits - 3);
+  return (size + step - 1) & ~(step - 1);
+}
+
+uint8_t* BufferPool::popBuffer(size_t capacity) {
+  if (capacity > MAX_CAPACITY) return NULL;
+
+  auto found = freeBuffers.find(capacity);
+  if (found == freeBuffers.end() || found->second.empty()) return NULL;
+
+  uint8_t* buffer = found->second.back();
+  found->second.pop_back();
+  pooledBytes -= capacity;
+  return buffer;
+}
+
+bool BufferPool::pushBuffer(uint8_t* buffer, size_t capacity) {
+  if (capacity > MAX_CAPACITY) return false;
+  if (pooledBytes + capacity > MAX_POOLED_BYTES) return false;
+
+  freeBuffers[capacity].push_back(buffer);
+  pooledBytes += capacity;
+  return true;
+}
+
+uint8_t* BufferPool::acquire(size_t size, size_t& capacity) {
+  capacity = capacityFor(size);
+
+  uint8_t* buffer{NULL};
+  {
+    std::lock_guard<std::mutex> locker(poolMutex);
+    buffer = popBuffer(capacity);
+  }
+
+  return buffer ? buffer : new uint8_t[capacity];
+}
+
+void BufferPool::release(uint8_t* buffer, size_t capacity) {
+  if (!buffer) return;
+
+  bool kept{false};
+  {
+    std::lock_guard<std::mutex> locker(poolMutex);
+    kept = pushBuffer(buffer, capacity);
+  }
+
+  if (!kept) delete[] buffer;
+}
+
+BufferPool::Block* BufferPool::acquireBlock(size_t size) {
+  size_t capacity = capacityFor(size);
+
+  uint8_t* buffer{NULL};
+  Block* block{NULL};
+  {
+    std::lock_guard<std::mutex> locker(poolMutex);
+    buffer = popBuffer(capacity);
+    if (!freeBlocks.empty()) {
+      block = freeBlocks.back();
+      freeBlocks.pop_back();
+    }
+  }
+
+  // allocate whatever the pool was out of outside the lock
+  if (!buffer) buffer = new uint8_t[capacity];
+  if (!block) block = new Block;
+
+  block->data = buffer;
+  block->size = size;
+  block->capacity = capacity;
+  block->refs.store(1, std::memory_order_relaxed);
+  return block;
+}
+
+void BufferPool::releaseBlock(Block* block) {
+  uint8_t* buffer = block->data;
+  bool kept{false};
+  {
+    std::lock_guard<std::mutex> locker(poolMutex);
+    kept = pushBuffer(buffer, block->capacity);
+    if (freeBlocks.size() < MAX_POOLED_BLOCKS) {
+      freeBlocks.push_back(block);
+      block = NULL;
+    }
+  }
+
+  if (!kept) delete[] buffer;
+  delete block;
+}
+
+void BufferPool::clear() {
+  std::lock_guard<std::mutex> locker(poolMutex);
+
+  for (auto& [capacity, buffers] : freeBuffers)
+    for (uint8_t* buffer : buffers) delete[] buffer;
+  for (Block* block : freeBlocks) delete block;
+
+  freeBuffers.clear();
+  freeBlocks.clear();
+  pooledBytes = 0;
+}
+
+void PixelBuffer::reset() {
+  if (!block) return;
+
+  // the last handle returns the buffer and the Block
+  if (block->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    BufferPool::releaseBlock(block);
+  block = NULL;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// free lists of byte buffers by size class, so back to back renders and
+// encodes of similar sizes reuse memory instead of going to the allocator.
+// safe to use from any thread.
+struct BufferPool {
+  // smallest class, everything below rounds up to it
+  static const size_t MIN_CAPACITY{4096};
+  // larger buffers bypass the pool
+  static const size_t MAX_CAPACITY{64 << 20};
+  // free memory held on to across all classes, past this buffers are deleted
+  static const size_t MAX_POOLED_BYTES{96 << 20};
+  // spare Blocks held on to, they're small
+  static const size_t MAX_POOLED_BLOCKS{1024};
+
+  // a pooled buffer and its reference count, what PixelBuffer hands around
+  struct Block {
+    uint8_t* data{NULL};
+    size_t size{0};
+    size_t capacity{0};
+    std::atomic<int32_t> refs{0};
+  };
+
+  // a buffer of at least size bytes, capacity is its real size
+  static uint8_t* acquire(size_t size, size_t& capacity);
+  static void release(uint8_t* buffer, size_t capacity);
+
+  // a buffer of at least size bytes in a Block with one reference, both
+  // taken from the pool under one lock
+  static Block* acquireBlock(size_t size);
+  static void releaseBlock(Block* block);
+
+  // free every pooled buffer and Block
+  static void clear();
+
+  // four classes per power of two, wastes at most a quarter
+  static size_t capacityFor(size_t size);
+
+private:
+  inline static std::mutex poolMutex;
+  inline static std::map<size_t, std::vector<uint8_t*>> freeBuffers;
+  inline static size_t pooledBytes{0};
+  inline static std::vector<Block*> freeBlocks;
+
+  // poolMutex held. NULL if there's none of that capacity.
+  static uint8_t* popBuffer(size_t capacity);
+  // poolMutex held. false if the pool is full and buffer wasn't kept.
+  static bool pushBuffer(uint8_t* buffer, size_t capacity);
+};
+
+// shared handle to a pooled buffer. copies share the bytes, which go back to
+// the pool when the last handle is gone.
+struct PixelBuffer {
+  PixelBuffer() = default;
+  explicit PixelBuffer(size_t size): block(BufferPool::acquireBlock(size)) {}
+  PixelBuffer(const PixelBuffer& other): block(other.block) {
+    if (block) block->refs.fetch_add(1, std::memory_order_relaxed);
+  }
+  PixelBuffer(PixelBuffer&& other) noexcept: block(other.block) {
+    other.block = NULL;
+  }
+  ~PixelBuffer() { reset(); }
+
+  PixelBuffer& operator=(PixelBuffer other) noexcept {
+    std::swap(block, other.block);
+    return *this;
+  }
+
+  uint8_t* data() const { return block ? block->data : NULL; }
+  size_t size() const { return block ? block->size : 0; }
+  explicit operator bool() const { return block != NULL; }
+
+  void reset();
+
+private:
+  BufferPool::Block* block{NULL};
+};
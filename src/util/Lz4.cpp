@@ -0,0 +1,121 @@
+#include "Lz4.hpp"
+
+#include <cstring>
+#include <vector>
+
+// match finder table, kept per thread so encodes don't allocate and zero it.
+// entries are base + position + 1, anything at or below an encode's base was
+// left by an earlier one and reads as empty.
+static thread_local std::vector<uint32_t> hashTable;
+static thread_local uint32_t hashBase{0};
+
+int64_t Lz4::bound(int64_t size) {
+  return size + size / 255 + 16;
+}
+
+static inline uint32_t read32(const uint8_t* p) {
+  uint32_t value;
+  memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+static inline uint32_t hash(uint32_t sequence) {
+  return (sequence * 2654435761u) >> (32 - Lz4::HASH_BITS);
+}
+
+// 15 in a token nibble means the length continues in 255 sized steps
+static inline uint8_t* writeLength(uint8_t* op, int64_t length) {
+  for (; length >= 255; length -= 255) *op++ = 255;
+  *op++ = length;
+  return op;
+}
+
+static inline uint8_t* writeLiterals(
+  uint8_t* op,
+  uint8_t* token,
+  const uint8_t* literals,
+  int64_t length
+) {
+  if (length >= 15) {
+    *token = 15 << 4;
+    op = writeLength(op, length - 15);
+  } else {
+    *token = length << 4;
+  }
+  memcpy(op, literals, length);
+  return op + length;
+}
+
+int64_t Lz4::compress(const uint8_t* src, int64_t size, uint8_t* dst) {
+  uint8_t* op = dst;
+  int64_t anchor{0};
+
+  if (size > MF_LIMIT) {
+    if (hashTable.empty() || (uint64_t)hashBase + size + 1 > UINT32_MAX) {
+      hashTable.assign(1 << HASH_BITS, 0);
+      hashBase = 0;
+    }
+    // a plain pointer, stores through it can't be the vector's own
+    uint32_t* table = hashTable.data();
+    const uint32_t base = hashBase;
+    hashBase += size + 1;
+
+    const int64_t matchLimit = size - LAST_LITERALS;
+    const int64_t searchLimit = size - MF_LIMIT;
+    int64_t ip{0};
+    // skip ahead faster the longer nothing matches
+    int32_t misses{0};
+
+    while (ip < searchLimit) {
+      uint32_t sequence = read32(src + ip);
+      uint32_t& slot = table[hash(sequence)];
+      int64_t ref = slot > base ? (int64_t)(slot - base) - 1 : -1;
+      slot = base + ip + 1;
+
+      if (
+        ref < 0
+          || ip - ref > MAX_OFFSET
+          || read32(src + ref) != sequence
+      ) {
+        ip += 1 + (misses++ >> 6);
+        continue;
+      }
+      misses = 0;
+
+      // grow the match back into the pending literals
+      while (ip > anchor && ref > 0 && src[ip - 1] == src[ref - 1]) {
+        --ip;
+        --ref;
+      }
+
+      int64_t length = MIN_MATCH;
+      while (ip + length < matchLimit && src[ip + length] == src[ref + length])
+        ++length;
+
+      uint8_t* token = op++;
+      op = writeLiterals(op, token, src + anchor, ip - anchor);
+
+      uint16_t offset = ip - ref;
+      *op++ = offset & 0xFF;
+      *op++ = offset >> 8;
+
+      int64_t extra = length - MIN_MATCH;
+      if (extra >= 15) {
+        *token |= 15;
+        op = writeLength(op, extra - 15);
+      } else {
+        *token |= extra;
+      }
+
+      ip += length;
+      anchor = ip;
+
+      if (ip - 2 < searchLimit) table[hash(read32(src + ip - 2))] = base + ip - 2 + 1;
+    }
+  }
+
+  uint8_t* token = op++;
+  op = writeLiterals(op, token, src + anchor, size - anchor);
+
+  return op - dst;
+}
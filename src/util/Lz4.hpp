@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+
+// compressor for the LZ4 block format, the one every LZ4 library decodes with
+// LZ4_decompress_safe. no frame header, the decoded size travels with the
+// data's metadata.
+struct Lz4 {
+  static const int32_t MIN_MATCH{4};
+  // the block format requires the last 5 bytes be literals, and the last
+  // match start at least 12 bytes from the end
+  static const int32_t LAST_LITERALS{5};
+  static const int32_t MF_LIMIT{12};
+  static const int32_t MAX_OFFSET{65535};
+  static const int32_t HASH_BITS{16};
+
+  // worst case compressed size, incompressible input grows slightly
+  static int64_t bound(int64_t size);
+
+  // compresses size bytes of src into dst, which must hold bound(size) bytes.
+  // returns the compressed length.
+  static int64_t compress(const uint8_t* src, int64_t size, uint8_t* dst);
+};
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// fixed size lock-free queue for exactly one producer thread and one
+// consumer thread, nothing allocates after construction. safe for the
+// audio thread.
+template <typename T, size_t CAPACITY>
+struct SpscRing {
+  static_assert(
+    CAPACITY > 0 && (CAPACITY & (CAPACITY - 1)) == 0,
+    "CAPACITY must be a power of 2"
+  );
+
+  // producer. false if the ring is full.
+  bool push(const T& item) {
+    size_t head = writeIndex.load(std::memory_order_relaxed);
+    if (head - readIndex.load(std::memory_order_acquire) == CAPACITY)
+      return false;
+
+    items[head & (CAPACITY - 1)] = item;
+    writeIndex.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // consumer. false if the ring is empty.
+  bool pop(T& item) {
+    size_t tail = readIndex.load(std::memory_order_relaxed);
+    if (tail == writeIndex.load(std::memory_order_acquire)) return false;
+
+    item = items[tail & (CAPACITY - 1)];
+    readIndex.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // items waiting, exact from either thread's point of view at the time
+  size_t size() const {
+    return writeIndex.load(std::memory_order_acquire) -
+      readIndex.load(std::memory_order_acquire);
+  }
+
+  bool empty() const {
+    return readIndex.load(std::memory_order_acquire) ==
+      writeIndex.load(std::memory_order_acquire);
+  }
+
+private:
+  // on their own cache lines so the two threads don't contend
+  alignas(64) std::atomic<size_t> writeIndex{0};
+  alignas(64) std::atomic<size_t> readIndex{0};
+  std::array<T, CAPACITY> items;
+};
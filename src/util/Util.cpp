@@ -14,6 +14,17 @@ rack::math::Vec vec2cm(const rack::math::Vec& pxVec) {
   );
 }
 
+float cm2px(const float& cm) {
+  return cm * 10.f * (rack::window::SVG_DPI / rack::window::MM_PER_IN);
+}
+
+rack::math::Vec vec2px(const rack::math::Vec& cmVec) {
+  return rack::math::Vec(
+    cm2px(cmVec.x),
+    cm2px(cmVec.y)
+  );
+}
+
 int64_t makeRackId() {
   return rack::random::u64() % (1ull << 53);
 }
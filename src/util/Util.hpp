@@ -9,6 +9,8 @@ int64_t makeRackId();
 
 float px2cm(const float& px);
 rack::math::Vec vec2cm(const rack::math::Vec& pxVec);
+float cm2px(const float& cm);
+rack::math::Vec vec2px(const rack::math::Vec& cmVec);
 
 rack::plugin::Model* findModel(std::string pluginSlug, std::string moduleSlug);
 rack::app::ModuleWidget* makeModuleWidget(rack::plugin::Model* model);
@@ -0,0 +1,49 @@
+#include "WorkerPool.hpp"
+
+#include <algorithm>
+
+WorkerPool::WorkerPool(size_t numThreads) {
+  if (numThreads == 0) {
+    size_t cores = std::thread::hardware_concurrency();
+    numThreads = std::max<size_t>(1, cores > 1 ? cores - 1 : 1);
+  }
+
+  for (size_t i = 0; i < numThreads; ++i)
+    workers.emplace_back([this]() { work(); });
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::lock_guard<std::mutex> locker(jobMutex);
+    running = false;
+  }
+  jobCondition.notify_all();
+
+  for (std::thread& worker : workers)
+    if (worker.joinable()) worker.join();
+}
+
+void WorkerPool::enqueue(Job job) {
+  {
+    std::lock_guard<std::mutex> locker(jobMutex);
+    jobs.push(std::move(job));
+  }
+  jobCondition.notify_one();
+}
+
+void WorkerPool::work() {
+  while (true) {
+    Job job;
+
+    {
+      std::unique_lock<std::mutex> locker(jobMutex);
+      jobCondition.wait(locker, [this]() { return !running || !jobs.empty(); });
+      if (!running) return;
+
+      job = std::move(jobs.front());
+      jobs.pop();
+    }
+
+    job();
+  }
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// fixed set of threads working through a shared queue of jobs.
+// jobs still queued when the pool is destroyed are dropped.
+struct WorkerPool {
+  typedef std::function<void(void)> Job;
+
+  // 0 picks one thread per core, leaving one for Rack's UI/engine threads
+  WorkerPool(size_t numThreads = 0);
+  ~WorkerPool();
+
+  void enqueue(Job job);
+
+private:
+  std::vector<std::thread> workers;
+  std::atomic<bool> running{true};
+
+  std::queue<Job> jobs;
+  std::mutex jobMutex;
+  std::condition_variable jobCondition;
+
+  void work();
+};
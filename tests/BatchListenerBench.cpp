@@ -0,0 +1,84 @@
+#include <rack.hpp>
+#include "osc/BatchListener.hpp"
+#include "Bench.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <thread>
+
+#include "oscpack/ip/UdpSocket.h"
+#include "oscpack/osc/OscOutboundPacketStream.h"
+#include "oscpack/osc/OscPacketListener.h"
+
+// datagrams per second of receiver cpu time under a loopback flood of
+// /ack_chunk, oscpack's one recvfrom per datagram against BatchListener's
+// recvmmsg. linux only, like BatchListener.
+
+static const int64_t DATAGRAMS{400000};
+
+struct CountingListener : osc::OscPacketListener {
+  std::atomic<int64_t> count{0};
+
+  void ProcessMessage(const osc::ReceivedMessage& message, const IpEndpointName&) override {
+    osc::ReceivedMessage::const_iterator args = message.ArgumentsBegin();
+    keep((args++)->AsInt64());
+    keep((args++)->AsInt32());
+    ++count;
+  }
+};
+
+static double threadCpuSeconds() {
+  timespec now;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+  return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+template <typename Socket>
+static bool flood(const char* name, int port) {
+  CountingListener listener;
+  Socket socket(IpEndpointName(IpEndpointName::ANY_ADDRESS, port), &listener);
+
+  double cpuSeconds{0};
+  std::thread receiver([&] {
+    socket.Run();
+    cpuSeconds = threadCpuSeconds();
+  });
+
+  UdpTransmitSocket transmit(IpEndpointName("127.0.0.1", port));
+  char buffer[256];
+
+  auto start = std::chrono::steady_clock::now();
+  for (int64_t i = 0; i < DATAGRAMS; ++i) {
+    osc::OutboundPacketStream message(buffer, sizeof(buffer));
+    message << osc::BeginMessage("/ack_chunk")
+      << i << (int32_t)1
+      << osc::EndMessage;
+    transmit.Send(message.Data(), message.Size());
+  }
+
+  // loopback drops what the receive buffer can't hold, give the rest 3s
+  while (listener.count < DATAGRAMS
+    && std::chrono::steady_clock::now() - start < std::chrono::seconds(3))
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  int64_t received = listener.count;
+  socket.AsynchronousBreak();
+  receiver.join();
+
+  printf(
+    "  %-10s received %7lld/%lld  receiver cpu %6.3f s  %9.0f datagrams/cpu s\n",
+    name, (long long)received, (long long)DATAGRAMS,
+    cpuSeconds, received / cpuSeconds
+  );
+  return received > 0;
+}
+
+int main() {
+  printf("BatchListenerBench: %lld datagrams over loopback\n", (long long)DATAGRAMS);
+  bool ok = flood<UdpListeningReceiveSocket>("oscpack", 9101);
+  ok = flood<BatchListener>("recvmmsg", 9102) && ok;
+  return ok ? 0 : 1;
+}
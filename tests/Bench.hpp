@@ -0,0 +1,25 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+
+// best wall time of runs calls to fn, seconds. the best run is the one least
+// disturbed by the rest of the machine.
+template <typename Fn>
+double bestOf(int runs, Fn fn) {
+  double best{1e30};
+  for (int run = 0; run < runs; ++run) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+    best = std::min(best, elapsed.count());
+  }
+  return best;
+}
+
+// keeps the compiler from dropping work whose result isn't used
+template <typename T>
+void keep(const T& value) {
+  asm volatile("" : : "g"(&value) : "memory");
+}
@@ -0,0 +1,95 @@
+#include "util/BufferPool.hpp"
+#include "Check.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+static void testCapacityFor() {
+  CHECK(BufferPool::capacityFor(1) == BufferPool::MIN_CAPACITY);
+  CHECK(BufferPool::capacityFor(BufferPool::MIN_CAPACITY) == BufferPool::MIN_CAPACITY);
+  // a quarter step above a power of two
+  CHECK(BufferPool::capacityFor((1 << 20) + 1) == (1 << 20) + (1 << 18));
+  CHECK(BufferPool::capacityFor(1 << 20) == 1 << 20);
+  // past the pool, exact
+  size_t huge = BufferPool::MAX_CAPACITY + 3;
+  CHECK(BufferPool::capacityFor(huge) == huge);
+}
+
+static void testHandles() {
+  BufferPool::clear();
+
+  PixelBuffer empty;
+  CHECK(!empty);
+  CHECK(empty.data() == NULL);
+  CHECK(empty.size() == 0);
+
+  PixelBuffer a(1000);
+  CHECK(a);
+  CHECK(a.size() == 1000);
+  std::memset(a.data(), 7, a.size());
+
+  // copies share the bytes
+  PixelBuffer b = a;
+  CHECK(b.data() == a.data());
+
+  // moves take the handle
+  PixelBuffer c = std::move(b);
+  CHECK(!b);
+  CHECK(c.data() == a.data());
+
+  PixelBuffer d(1000);
+  d = c;
+  CHECK(d.data() == a.data());
+  d = d;
+  CHECK(d.data() == a.data());
+
+  // still referenced, so a new buffer can't be the same one
+  uint8_t* data = a.data();
+  a.reset();
+  c.reset();
+  PixelBuffer e(1000);
+  CHECK(e.data() != data);
+  CHECK(d.data()[999] == 7);
+
+  // the last handle gone, the buffer goes back to the pool and is reused
+  d.reset();
+  PixelBuffer f(900);
+  CHECK(f.data() == data);
+  CHECK(f.size() == 900);
+}
+
+static void testThreads() {
+  BufferPool::clear();
+
+  // copies and resets racing across threads, every buffer keeps its bytes
+  PixelBuffer shared(64);
+  std::memset(shared.data(), 3, shared.size());
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&shared, t]() {
+      for (int i = 0; i < 20000; ++i) {
+        PixelBuffer copy = shared;
+        PixelBuffer own(64 + i % 3 * 4096);
+        std::memset(own.data(), t, own.size());
+        if (copy.data()[63] != 3 || own.data()[0] != t) {
+          std::fprintf(stderr, "BufferPoolTest: thread %d saw a clobbered buffer\n", t);
+          std::abort();
+        }
+      }
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+
+  CHECK(shared.data()[0] == 3);
+  BufferPool::clear();
+}
+
+int main() {
+  testCapacityFor();
+  testHandles();
+  testThreads();
+  return checkResult("BufferPoolTest");
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdio>
+
+// no framework, a failed check prints where and the test binary exits 1
+inline int checkFailures{0};
+
+#define CHECK(expr) \
+  do { \
+    if (!(expr)) { \
+      std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #expr); \
+      ++checkFailures; \
+    } \
+  } while (0)
+
+inline int checkResult(const char* name) {
+  if (checkFailures) {
+    std::fprintf(stderr, "%s: %d failed\n", name, checkFailures);
+    return 1;
+  }
+  std::printf("%s: ok\n", name);
+  return 0;
+}
@@ -0,0 +1,200 @@
+#include "texture/ImageCodec.hpp"
+#include "util/Lz4.hpp"
+#include "Bench.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#define QOI_IMPLEMENTATION
+#include "qoi/qoi.h"
+
+// encode time, decode time and ratio per codec over a corpus of renders.
+//   ImageCodecBench [render.qoi ...]
+// renders are premultiplied RGBA saved as qoi. a render.previous.qoi next to
+// one is the frame before it, for DELTA. without any, the captures in
+// corpus/ are used, see corpus/README.md.
+
+struct Image {
+  std::string name;
+  int32_t width{0};
+  int32_t height{0};
+  std::vector<uint8_t> pixels;
+  // the frame before, for DELTA. empty if the image isn't an overlay.
+  std::vector<uint8_t> previous;
+};
+
+// LZ4 block decoder, the client's side of ImageCodec::LZ4
+static bool decodeLz4(const uint8_t* src, int64_t length, uint8_t* dst, int64_t size) {
+  const uint8_t* end = src + length;
+  uint8_t* out = dst;
+  uint8_t* outEnd = dst + size;
+
+  while (src < end) {
+    uint8_t token = *src++;
+
+    int64_t literals = token >> 4;
+    if (literals == 15) {
+      uint8_t more;
+      do {
+        if (src >= end) return false;
+        more = *src++;
+        literals += more;
+      } while (more == 255);
+    }
+    if (literals > end - src || literals > outEnd - out) return false;
+    std::memcpy(out, src, literals);
+    src += literals;
+    out += literals;
+
+    // the last sequence is literals only
+    if (src >= end) break;
+
+    if (end - src < 2) return false;
+    int64_t offset = src[0] | (src[1] << 8);
+    src += 2;
+    if (offset == 0 || offset > out - dst) return false;
+
+    int64_t match = (token & 15) + Lz4::MIN_MATCH;
+    if ((token & 15) == 15) {
+      uint8_t more;
+      do {
+        if (src >= end) return false;
+        more = *src++;
+        match += more;
+      } while (more == 255);
+    }
+    if (match > outEnd - out) return false;
+
+    // overlapping copies repeat the pattern, byte by byte
+    const uint8_t* from = out - offset;
+    for (int64_t i = 0; i < match; ++i) out[i] = from[i];
+    out += match;
+  }
+
+  return out == outEnd;
+}
+
+static bool decode(
+  ImageCodec::Id codec,
+  const Image& image,
+  const uint8_t* encoded,
+  int64_t length,
+  uint8_t* out
+) {
+  int64_t size = (int64_t)image.width * image.height * 4;
+
+  switch (codec) {
+    case ImageCodec::QOI: {
+      qoi_desc desc;
+      void* decoded = qoi_decode(encoded, length, &desc, 4);
+      if (!decoded) return false;
+      std::memcpy(out, decoded, size);
+      free(decoded);
+      return true;
+    }
+    case ImageCodec::RAW:
+      if (length != size) return false;
+      std::memcpy(out, encoded, size);
+      return true;
+    case ImageCodec::LZ4:
+      return decodeLz4(encoded, length, out, size);
+    case ImageCodec::DELTA:
+      if (!decodeLz4(encoded, length, out, size)) return false;
+      for (int64_t i = 0; i < size; ++i) out[i] ^= image.previous[i];
+      return true;
+    default:
+      return false;
+  }
+}
+
+static bool readQoi(const std::string& path, int32_t& width, int32_t& height, std::vector<uint8_t>& out) {
+  qoi_desc desc;
+  void* pixels = qoi_read(path.c_str(), &desc, 4);
+  if (!pixels) return false;
+
+  width = desc.width;
+  height = desc.height;
+  out.assign((uint8_t*)pixels, (uint8_t*)pixels + (size_t)desc.width * desc.height * 4);
+  free(pixels);
+  return true;
+}
+
+static bool loadQoi(const std::string& path, Image& image) {
+  image.name = path;
+  if (!readQoi(path, image.width, image.height, image.pixels)) return false;
+
+  // optional, a missing or mismatched previous frame just skips DELTA
+  std::string previousPath = path.substr(0, path.size() - 4) + ".previous.qoi";
+  int32_t width, height;
+  std::vector<uint8_t> previous;
+  if (readQoi(previousPath, width, height, previous)) {
+    if (width == image.width && height == image.height) image.previous = previous;
+    else std::fprintf(stderr, "ImageCodecBench: %s doesn't match its frame, skipping DELTA\n", previousPath.c_str());
+  }
+  return true;
+}
+
+int main(int argc, char** argv) {
+  // relative to tests/, where make bench runs
+  std::vector<std::string> paths{
+    "corpus/OSCctrl_panel.qoi",
+    "corpus/OSCctrl_logo.qoi",
+    "corpus/OSCctrl_lights.qoi"
+  };
+  if (argc > 1) paths.assign(argv + 1, argv + argc);
+
+  std::vector<Image> corpus;
+  for (const std::string& path : paths) {
+    Image image;
+    if (loadQoi(path, image)) corpus.push_back(image);
+    else std::fprintf(stderr, "ImageCodecBench: can't read %s, skipping\n", path.c_str());
+  }
+  if (corpus.empty()) {
+    std::fprintf(stderr, "ImageCodecBench: nothing to run, the corpus is read from tests/\n");
+    return 1;
+  }
+
+  const int RUNS{10};
+  const ImageCodec::Id codecs[]{
+    ImageCodec::QOI, ImageCodec::RAW, ImageCodec::LZ4, ImageCodec::DELTA
+  };
+
+  std::printf("ImageCodecBench: best of %d\n", RUNS);
+  for (const Image& image : corpus) {
+    int64_t size = (int64_t)image.width * image.height * 4;
+    std::vector<uint8_t> decoded(size);
+    std::printf("  %s\n", image.name.c_str());
+
+    for (ImageCodec::Id codec : codecs) {
+      if (codec == ImageCodec::DELTA && image.previous.empty()) continue;
+      const uint8_t* previous = image.previous.empty() ? NULL : image.previous.data();
+
+      int64_t length{0};
+      PixelBuffer encoded;
+      double encodeTime = bestOf(RUNS, [&]() {
+        encoded = ImageCodec::encode(
+          codec, image.pixels.data(), image.width, image.height, 4, length, previous
+        );
+      });
+
+      bool ok{false};
+      double decodeTime = bestOf(RUNS, [&]() {
+        ok = decode(codec, image, encoded.data(), length, decoded.data());
+      });
+      ok = ok && decoded == image.pixels;
+
+      std::printf(
+        "    %-6s encode %8.3f ms  decode %8.3f ms  %9lld bytes  ratio %6.2f%s\n",
+        ImageCodec::name(codec),
+        encodeTime * 1e3,
+        decodeTime * 1e3,
+        (long long)length,
+        (double)size / length,
+        ok ? "" : "  ROUND TRIP FAILED"
+      );
+      if (!ok) return 1;
+    }
+  }
+}
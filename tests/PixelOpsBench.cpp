@@ -0,0 +1,66 @@
+#include "texture/PixelOps.hpp"
+#include "Bench.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// what Renderer::flipBitmap did before PixelOps: a row sized stack array and
+// three memcpys per pair of rows
+static void flipRowsVla(uint8_t* pixels, int width, int height) {
+  size_t rowSize = (size_t)width * 4;
+  uint8_t* tmp = (uint8_t*)__builtin_alloca(rowSize);
+  for (int y = 0; y < height / 2; ++y) {
+    uint8_t* row = pixels + y * rowSize;
+    uint8_t* flipRow = pixels + (height - y - 1) * rowSize;
+    std::memcpy(tmp, row, rowSize);
+    std::memcpy(row, flipRow, rowSize);
+    std::memcpy(flipRow, tmp, rowSize);
+  }
+}
+
+int main() {
+  // a 4K tall render of a wide panel, transparent margin around the middle
+  const int width{2048}, height{3840};
+  const size_t size = (size_t)width * height * 4;
+  const int RUNS{20};
+
+  std::vector<uint8_t> pixels(size, 0);
+  for (int y = 64; y < height - 64; ++y)
+    std::memset(pixels.data() + ((size_t)y * width + 32) * 4, 0xFF, (width - 64) * 4);
+  std::vector<uint8_t> dst(size);
+
+  auto report = [&](const char* name, double seconds) {
+    std::printf(
+      "  %-28s %7.3f ms  %6.2f GB/s\n",
+      name,
+      seconds * 1e3,
+      size / seconds / 1e9
+    );
+  };
+
+  std::printf("PixelOpsBench: %dx%d rgba, best of %d\n", width, height, RUNS);
+
+  report("flipRows (old, VLA)", bestOf(RUNS, [&]() {
+    flipRowsVla(pixels.data(), width, height);
+  }));
+  report("flipRows", bestOf(RUNS, [&]() {
+    PixelOps::flipRows(pixels.data(), width, height);
+  }));
+  report("copyRegion", bestOf(RUNS, [&]() {
+    PixelOps::copyRegion(pixels.data(), width, 0, 0, width, height, dst.data());
+  }));
+  // the fused trim: one pass that crops and flips
+  report("copyRegion flipped", bestOf(RUNS, [&]() {
+    PixelOps::copyRegion(
+      pixels.data(), width, 0, 0, width, height, dst.data(), true
+    );
+  }));
+  report("findAlphaBounds", bestOf(RUNS, [&]() {
+    int left, top, right, bottom;
+    PixelOps::findAlphaBounds(
+      pixels.data(), width, height, left, top, right, bottom
+    );
+    keep(left);
+  }));
+}
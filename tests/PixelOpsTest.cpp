@@ -0,0 +1,151 @@
+#include "texture/PixelOps.hpp"
+#include "Check.hpp"
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+typedef std::vector<uint8_t> Pixels;
+
+// every byte different, so a misplaced row or column shows
+static Pixels makeImage(int width, int height) {
+  Pixels pixels((size_t)width * height * 4);
+  for (size_t i = 0; i < pixels.size(); ++i) pixels[i] = (i * 7 + i / 251) & 0xFF;
+  return pixels;
+}
+
+static const uint8_t* pixelAt(const Pixels& pixels, int width, int x, int y) {
+  return pixels.data() + ((size_t)y * width + x) * 4;
+}
+
+static void testFlipRows() {
+  for (int height : {0, 1, 2, 3, 8, 17}) {
+    for (int width : {1, 5, 64}) {
+      Pixels original = makeImage(width, height);
+      Pixels flipped = original;
+      PixelOps::flipRows(flipped.data(), width, height);
+
+      for (int y = 0; y < height; ++y) {
+        CHECK(!std::memcmp(
+          pixelAt(flipped, width, 0, y),
+          pixelAt(original, width, 0, height - y - 1),
+          width * 4
+        ));
+      }
+
+      // twice is a no-op
+      PixelOps::flipRows(flipped.data(), width, height);
+      CHECK(flipped == original);
+    }
+  }
+}
+
+static void testCopyRegion() {
+  const int width{13}, height{9};
+  Pixels src = makeImage(width, height);
+
+  for (bool flip : {false, true}) {
+    const int left{3}, top{2}, regionWidth{7}, regionHeight{5};
+    Pixels dst((size_t)regionWidth * regionHeight * 4);
+    PixelOps::copyRegion(
+      src.data(), width, left, top, regionWidth, regionHeight, dst.data(), flip
+    );
+
+    for (int y = 0; y < regionHeight; ++y) {
+      int srcY = top + (flip ? regionHeight - y - 1 : y);
+      CHECK(!std::memcmp(
+        pixelAt(dst, regionWidth, 0, y),
+        pixelAt(src, width, left, srcY),
+        regionWidth * 4
+      ));
+    }
+  }
+
+  // the whole image is a plain copy
+  Pixels whole(src.size());
+  PixelOps::copyRegion(src.data(), width, 0, 0, width, height, whole.data());
+  CHECK(whole == src);
+}
+
+// per pixel reference for findAlphaBounds
+static bool naiveAlphaBounds(
+  const Pixels& pixels,
+  int width,
+  int height,
+  int& left,
+  int& top,
+  int& right,
+  int& bottom
+) {
+  bool found = false;
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      if (!pixelAt(pixels, width, x, y)[3]) continue;
+      if (!found) {
+        left = right = x;
+        top = bottom = y;
+        found = true;
+      }
+      left = std::min(left, x);
+      right = std::max(right, x);
+      top = std::min(top, y);
+      bottom = std::max(bottom, y);
+    }
+  }
+  return found;
+}
+
+static void testFindAlphaBounds() {
+  int left, top, right, bottom;
+
+  // fully transparent, color without alpha doesn't count
+  Pixels clear((size_t)16 * 8 * 4, 0);
+  for (size_t i = 0; i < clear.size(); i += 4) clear[i] = 0xFF;
+  CHECK(!PixelOps::findAlphaBounds(clear.data(), 16, 8, left, top, right, bottom));
+
+  // a single pixel in each corner
+  for (int corner = 0; corner < 4; ++corner) {
+    int x = corner & 1 ? 15 : 0;
+    int y = corner & 2 ? 7 : 0;
+    Pixels pixels((size_t)16 * 8 * 4, 0);
+    pixels[((size_t)y * 16 + x) * 4 + 3] = 1;
+
+    CHECK(PixelOps::findAlphaBounds(pixels.data(), 16, 8, left, top, right, bottom));
+    CHECK(left == x && right == x && top == y && bottom == y);
+  }
+
+  // sparse random images against the reference
+  std::mt19937 random(1);
+  for (int i = 0; i < 200; ++i) {
+    int width = 1 + random() % 40;
+    int height = 1 + random() % 40;
+    Pixels pixels((size_t)width * height * 4, 0);
+    int dots = random() % 4;
+    for (int dot = 0; dot < dots; ++dot) {
+      size_t pixel = random() % ((size_t)width * height);
+      pixels[pixel * 4 + 3] = 1 + random() % 255;
+    }
+
+    int expectedLeft{-1}, expectedTop{-1}, expectedRight{-1}, expectedBottom{-1};
+    bool expected = naiveAlphaBounds(
+      pixels, width, height, expectedLeft, expectedTop, expectedRight, expectedBottom
+    );
+    bool found = PixelOps::findAlphaBounds(
+      pixels.data(), width, height, left, top, right, bottom
+    );
+
+    CHECK(found == expected);
+    if (!found || !expected) continue;
+    CHECK(left == expectedLeft);
+    CHECK(top == expectedTop);
+    CHECK(right == expectedRight);
+    CHECK(bottom == expectedBottom);
+  }
+}
+
+int main() {
+  testFlipRows();
+  testCopyRegion();
+  testFindAlphaBounds();
+  return checkResult("PixelOpsTest");
+}
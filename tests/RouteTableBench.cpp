@@ -0,0 +1,163 @@
+#include "osc/RouteTable.hpp"
+#include "Bench.hpp"
+
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "oscpack/osc/OscOutboundPacketStream.h"
+#include "oscpack/osc/OscPacketListener.h"
+
+// messages per second through ProcessMessage, the receiver thread's
+// dispatch, with handlers that only parse their arguments
+
+typedef RouteTable::Handler Handler;
+
+// the hot routes parse like their OscReceiver handlers, the rest take no args
+static Handler makeHandler(std::string_view path, int64_t& sink) {
+  if (path == "/set/param/value")
+    return [&sink](osc::ReceivedMessage::const_iterator& args, const IpEndpointName&) {
+      sink += (args++)->AsInt64();
+      sink += (args++)->AsInt32();
+      sink += (args++)->AsFloat();
+      sink += (args++)->AsBool();
+    };
+  if (path == "/ack_chunk")
+    return [&sink](osc::ReceivedMessage::const_iterator& args, const IpEndpointName&) {
+      sink += (args++)->AsInt64();
+      sink += (args++)->AsInt32();
+    };
+  if (path == "/get/texture")
+    return [&sink](osc::ReceivedMessage::const_iterator& args, const IpEndpointName&) {
+      sink += (args++)->AsInt64();
+      sink += (args++)->AsFloat();
+    };
+  return [&sink](osc::ReceivedMessage::const_iterator&, const IpEndpointName&) {
+    ++sink;
+  };
+}
+
+// ProcessMessage before RouteTable: a std::string per message and two walks
+// of a std::map
+struct MapReceiver : osc::OscPacketListener {
+  std::map<std::string, Handler> routes;
+  int64_t sink{0};
+
+  MapReceiver() {
+    for (std::string_view path : ROUTE_PATHS)
+      routes.emplace(std::string(path), makeHandler(path, sink));
+  }
+
+  void ProcessMessage(
+    const osc::ReceivedMessage& message,
+    const IpEndpointName& remoteEndpoint
+  ) override {
+    try {
+      std::string address = message.AddressPattern();
+      if (!routes.count(address)) throw osc::Exception("no route for address");
+
+      osc::ReceivedMessage::const_iterator argsIterator = message.ArgumentsBegin();
+      routes.at(address)(argsIterator, remoteEndpoint);
+
+      if (argsIterator != message.ArgumentsEnd())
+        throw osc::ExcessArgumentException();
+    } catch(osc::Exception& e) {
+      WARN("error parsing OSC message %s: %s", message.AddressPattern(), e.what());
+    }
+  }
+};
+
+// OscReceiver::ProcessMessage as it is
+struct HashReceiver : osc::OscPacketListener {
+  RouteTable routes;
+  int64_t sink{0};
+
+  HashReceiver() {
+    for (std::string_view path : ROUTE_PATHS)
+      routes.emplace(std::string(path).c_str(), makeHandler(path, sink));
+  }
+
+  void ProcessMessage(
+    const osc::ReceivedMessage& message,
+    const IpEndpointName& remoteEndpoint
+  ) override {
+    try {
+      const RouteTable::Handler* route = routes.find(message.AddressPattern());
+      if (!route) throw osc::Exception("no route for address");
+
+      osc::ReceivedMessage::const_iterator argsIterator = message.ArgumentsBegin();
+      (*route)(argsIterator, remoteEndpoint);
+
+      if (argsIterator != message.ArgumentsEnd())
+        throw osc::ExcessArgumentException();
+    } catch(osc::Exception& e) {
+      WARN("error parsing OSC message %s: %s", message.AddressPattern(), e.what());
+    }
+  }
+};
+
+struct Packet {
+  char data[128];
+  size_t size;
+};
+
+// a knob sweep with chunk acks and the odd texture request mixed in
+static std::vector<Packet> makePackets() {
+  std::vector<Packet> packets(1024);
+  for (size_t i = 0; i < packets.size(); ++i) {
+    Packet& packet = packets[i];
+    osc::OutboundPacketStream pstream(packet.data, sizeof(packet.data));
+
+    switch (i % 8) {
+      case 0: case 1: case 2: case 3:
+        pstream << osc::BeginMessage("/set/param/value")
+          << (int64_t)i << (int32_t)(i % 16) << 0.5f << false << osc::EndMessage;
+        break;
+      case 4: case 5:
+        pstream << osc::BeginMessage("/ack_chunk")
+          << (int64_t)i << (int32_t)(i % 64) << osc::EndMessage;
+        break;
+      case 6:
+        pstream << osc::BeginMessage("/keepalive") << osc::EndMessage;
+        break;
+      case 7:
+        pstream << osc::BeginMessage("/get/texture")
+          << (int64_t)i << 2.f << osc::EndMessage;
+        break;
+    }
+    packet.size = pstream.Size();
+  }
+  return packets;
+}
+
+template <typename Receiver>
+static void run(const char* name, const std::vector<Packet>& packets) {
+  const int ROUNDS{2000};
+  const int RUNS{5};
+  Receiver receiver;
+  IpEndpointName endpoint;
+
+  double seconds = bestOf(RUNS, [&]() {
+    for (int round = 0; round < ROUNDS; ++round) {
+      for (const Packet& packet : packets)
+        receiver.ProcessPacket(packet.data, packet.size, endpoint);
+    }
+  });
+  keep(receiver.sink);
+
+  double messages = (double)ROUNDS * packets.size();
+  std::printf(
+    "  %-32s %7.2f M messages/s  %6.1f ns/message\n",
+    name,
+    messages / seconds / 1e6,
+    seconds / messages * 1e9
+  );
+}
+
+int main() {
+  std::vector<Packet> packets = makePackets();
+  std::printf("RouteTableBench: ProcessPacket over %zu routes\n", ROUTE_PATHS.size());
+  run<MapReceiver>("std::map<std::string> (old)", packets);
+  run<HashReceiver>("RouteTable", packets);
+}
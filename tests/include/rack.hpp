@@ -0,0 +1,20 @@
+#pragma once
+
+// stands in for the Rack SDK's rack.hpp, just enough for the sources the
+// tests and benchmarks build without Rack
+
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+
+#define DEBUG(format, ...) std::fprintf(stderr, "[debug] " format "\n", ##__VA_ARGS__)
+#define INFO(format, ...) std::fprintf(stderr, "[info] " format "\n", ##__VA_ARGS__)
+#define WARN(format, ...) std::fprintf(stderr, "[warn] " format "\n", ##__VA_ARGS__)
+
+#if defined(__linux__) && !defined(ARCH_LIN)
+  #define ARCH_LIN
+#elif defined(__APPLE__) && !defined(ARCH_MAC)
+  #define ARCH_MAC
+#elif defined(_WIN32) && !defined(ARCH_WIN)
+  #define ARCH_WIN
+#endif